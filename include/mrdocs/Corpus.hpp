@@ -16,7 +16,10 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Metadata.hpp>
+#include <compare>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -40,15 +43,10 @@ protected:
 public:
     /** The iterator type for the index of all symbols.
 
-        The iterator is a forward iterator that
-        iterates over all symbols in the index.
+        The iterator is a random access iterator
+        over the array returned by @ref infos.
         It dereferences to a reference to a
         const @ref Info.
-
-        The logic for incrementing the iterator is
-        provided by the Corpus implementation via
-        a function that retuns the next Info in the
-        index, or nullptr if there are no more.
     */
     class iterator;
 
@@ -64,19 +62,28 @@ public:
     */
     Config const& config;
 
-    /** Return the begin iterator for the index of all symbols.
+    /** Return the index of all symbols.
+
+        The symbols are stored contiguously, ordered
+        by their symbol ID, so the order is stable
+        and the index can be split for a parallel
+        pass over the corpus. The index is valid
+        for the lifetime of the corpus.
     */
     MRDOCS_DECL
     virtual
+    std::span<Info const* const>
+    infos() const noexcept = 0;
+
+    /** Return the begin iterator for the index of all symbols.
+    */
     iterator
-    begin() const noexcept = 0;
+    begin() const noexcept;
 
     /** Return the end iterator for the index.
     */
-    MRDOCS_DECL
-    virtual
     iterator
-    end() const noexcept = 0;
+    end() const noexcept;
 
     /** Whether the corpus contains any symbols.
     */
@@ -91,6 +98,20 @@ public:
     Info const*
     find(SymbolID const& id) const noexcept = 0;
 
+    /** Return the position of a symbol in the index.
+
+        The position is the index of the symbol in
+        @ref infos, so data computed for every symbol
+        can be stored in a vector aligned with the
+        index and found without searching. If the
+        symbol does not exist, `infos().size()` is
+        returned.
+    */
+    MRDOCS_DECL
+    virtual
+    std::size_t
+    indexOf(SymbolID const& id) const noexcept = 0;
+
     /** Return true if an Info with the specified symbol ID exists.
 
         This function uses the @ref find function to locate
@@ -198,6 +219,18 @@ public:
     getFullyQualifiedName(
         const Info& I,
         std::string& temp) const;
+
+    /** Return the fully qualified name of the specified Info.
+
+        The names of all symbols are computed once,
+        when the corpus is built, so this does not
+        traverse the parents of `I`. The name is
+        valid for the lifetime of the corpus.
+    */
+    MRDOCS_DECL
+    virtual
+    std::string_view
+    qualifiedName(Info const& I) const noexcept = 0;
 };
 
 //------------------------------------------------
@@ -263,71 +296,124 @@ traverseOverloads(
 
 class Corpus::iterator
 {
-    const Corpus* corpus_;
-    const Info* val_;
-    const Info*(*next_)(const Corpus*, const Info*);
+    Info const* const* it_ = nullptr;
 
 public:
-    using value_type = const Info;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Info;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
-    using pointer = value_type*;
-    using reference = value_type&;
-    using const_pointer = const value_type*;
-    using const_reference = const value_type&;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+    using const_pointer = value_type const*;
+    using const_reference = value_type const&;
 
     iterator() = default;
     iterator(const iterator&) = default;
     iterator& operator=(const iterator&) = default;
 
-    iterator(
-        const Corpus* corpus,
-        const Info* val,
-        const Info*(*next)(const Corpus*, const Info*))
-        : corpus_(corpus)
-        , val_(val)
-        , next_(next)
+    explicit
+    iterator(Info const* const* it) noexcept
+        : it_(it)
     {
     }
 
     iterator& operator++() noexcept
     {
-        MRDOCS_ASSERT(val_);
-        val_ = next_(corpus_, val_);
+        ++it_;
         return *this;
     }
 
     iterator operator++(int) noexcept
     {
-        MRDOCS_ASSERT(val_);
-        auto temp = *this;
-        val_ = next_(corpus_, val_);
-        return temp;
+        return iterator(it_++);
     }
 
-    const_pointer operator->() const noexcept
+    iterator& operator--() noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return val_;
+        --it_;
+        return *this;
     }
 
-    const_reference operator*() const noexcept
+    iterator operator--(int) noexcept
+    {
+        return iterator(it_--);
+    }
+
+    iterator& operator+=(difference_type n) noexcept
+    {
+        it_ += n;
+        return *this;
+    }
+
+    iterator& operator-=(difference_type n) noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return *val_;
+        it_ -= n;
+        return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator+(difference_type n, iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator-(iterator it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(iterator a, iterator b) noexcept
+    {
+        return a.it_ - b.it_;
+    }
+
+    const_reference operator[](difference_type n) const noexcept
+    {
+        MRDOCS_ASSERT(it_[n]);
+        return *it_[n];
     }
 
-    bool operator==(iterator const& other) const noexcept
+    const_pointer operator->() const noexcept
     {
-        return val_ == other.val_;
+        MRDOCS_ASSERT(*it_);
+        return *it_;
     }
 
-    bool operator!=(iterator const& other) const noexcept
+    const_reference operator*() const noexcept
     {
-        return val_ != other.val_;
+        MRDOCS_ASSERT(*it_);
+        return **it_;
     }
+
+    bool operator==(iterator const& other) const noexcept = default;
+
+    auto operator<=>(iterator const& other) const noexcept = default;
 };
 
+inline
+auto
+Corpus::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(infos().data());
+}
+
+inline
+auto
+Corpus::
+end() const noexcept ->
+    iterator
+{
+    auto const index = infos();
+    return iterator(index.data() + index.size());
+}
+
 } // mrdocs
 } // clang
 
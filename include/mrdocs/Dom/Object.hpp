@@ -13,6 +13,7 @@
 
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Support/Error.hpp>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <vector>
@@ -395,15 +396,26 @@ newObject(Args&&... args)
 //------------------------------------------------
 
 /** The default Object implementation.
+
+    The entries are stored in insertion order.
+    Small objects are searched linearly. When
+    an object has more than `index_threshold`
+    entries, the keys are also indexed by a hash
+    table, so the cost of a lookup does not grow
+    with the number of keys.
 */
 class MRDOCS_DECL
     DefaultObjectImpl : public ObjectImpl
 {
 public:
+    /** Objects larger than this are indexed by a hash table.
+    */
+    static constexpr std::size_t index_threshold = 6;
+
     DefaultObjectImpl() noexcept;
 
     explicit DefaultObjectImpl(
-        storage_type entries) noexcept;
+        storage_type entries);
     std::size_t size() const override;
     Value get(std::string_view) const override;
     void set(String, Value) override;
@@ -411,7 +423,15 @@ public:
     bool exists(std::string_view key) const override;
 
 private:
+    std::size_t find(std::string_view key) const noexcept;
+    void insertIndex(std::size_t pos);
+    void reindex();
+
     storage_type entries_;
+
+    // Open addressing table of positions in
+    // entries_, empty for small objects.
+    std::vector<std::uint32_t> index_;
 };
 
 //------------------------------------------------
@@ -17,6 +17,7 @@
 #include <mrdocs/Metadata/Javadoc.hpp>
 #include <mrdocs/Metadata/Specifiers.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
+#include <mrdocs/Support/NodePool.hpp>
 #include <mrdocs/Support/Visitor.hpp>
 #include <array>
 #include <memory>
@@ -51,6 +52,7 @@ toString(InfoKind kind) noexcept;
 */
 struct MRDOCS_VISIBLE
     Info
+    : PoolAllocated
 {
     /** The unique identifier for this symbol.
     */
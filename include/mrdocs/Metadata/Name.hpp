@@ -15,6 +15,7 @@
 #include <mrdocs/Metadata/Info.hpp>
 #include <mrdocs/Metadata/Type.hpp>
 #include <mrdocs/Metadata/Template.hpp>
+#include <mrdocs/Support/NodePool.hpp>
 #include <memory>
 
 namespace clang {
@@ -33,6 +34,7 @@ toString(NameKind kind) noexcept;
 /** Represents a (possibly qualified) symbol name.
 */
 struct NameInfo
+    : PoolAllocated
 {
     /** The kind of name this is.
     */
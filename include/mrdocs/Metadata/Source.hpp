@@ -36,8 +36,13 @@ MRDOCS_DECL
 std::string_view
 toString(FileKind kind);
 
-struct MRDOCS_DECL
-    Location
+/** A file which contains declarations.
+
+    Files are interned: there is a single
+    object for each distinct file, which
+    every @ref Location in it refers to.
+*/
+struct SourceFile
 {
     /** The full file path
     */
@@ -47,13 +52,33 @@ struct MRDOCS_DECL
     */
     std::string Filename;
 
-    /** Line number within the file
-    */
-    unsigned LineNumber = 0;
-
     /** The kind of file this is
     */
     FileKind Kind = FileKind::Source;
+};
+
+/** Return the interned file with the given properties.
+
+    The returned object lives until the
+    program exits. This function is thread-safe.
+*/
+MRDOCS_DECL
+SourceFile const&
+internSourceFile(
+    std::string_view filepath,
+    std::string_view filename,
+    FileKind kind);
+
+struct MRDOCS_DECL
+    Location
+{
+    /** The file, or null if the location is empty
+    */
+    SourceFile const* File = nullptr;
+
+    /** Line number within the file
+    */
+    unsigned LineNumber = 0;
 
     /** Whether this location has documentation.
     */
@@ -61,19 +86,54 @@ struct MRDOCS_DECL
 
     //--------------------------------------------
 
+    Location() = default;
+
     Location(
-        std::string_view filepath = "",
-        std::string_view filename = "",
+        SourceFile const& file,
+        unsigned line,
+        bool documented = false) noexcept
+        : File(&file)
+        , LineNumber(line)
+        , Documented(documented)
+    {
+    }
+
+    Location(
+        std::string_view filepath,
+        std::string_view filename,
         unsigned line = 0,
         FileKind kind = FileKind::Source,
         bool documented = false)
-        : Path(filepath)
-        , Filename(filename)
+        : File(filename.empty() ? nullptr :
+            &internSourceFile(filepath, filename, kind))
         , LineNumber(line)
-        , Kind(kind)
         , Documented(documented)
     {
     }
+
+    /** The full file path
+    */
+    std::string_view
+    path() const noexcept
+    {
+        return File ? std::string_view(File->Path) : std::string_view();
+    }
+
+    /** Name of the file
+    */
+    std::string_view
+    filename() const noexcept
+    {
+        return File ? std::string_view(File->Filename) : std::string_view();
+    }
+
+    /** The kind of file this is
+    */
+    FileKind
+    kind() const noexcept
+    {
+        return File ? File->Kind : FileKind::Source;
+    }
 };
 
 struct LocationEmptyPredicate
@@ -81,7 +141,7 @@ struct LocationEmptyPredicate
     constexpr bool operator()(
         Location const& loc) const noexcept
     {
-        return loc.Filename.empty();
+        return ! loc.File;
     }
 };
 
@@ -159,10 +159,13 @@ template<>
 struct std::hash<clang::mrdocs::SymbolID>
 {
     std::size_t operator()(
-        const clang::mrdocs::SymbolID& id) const
+        const clang::mrdocs::SymbolID& id) const noexcept
     {
-        return std::hash<std::string_view>()(
-            std::string_view(id));
+        // the ID is already a SHA1 digest, so its
+        // leading bytes are uniformly distributed
+        std::uint64_t h;
+        std::memcpy(&h, id.data(), sizeof(h));
+        return static_cast<std::size_t>(h);
     }
 };
 
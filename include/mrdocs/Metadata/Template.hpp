@@ -16,6 +16,7 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/ADT/Optional.hpp>
 #include <mrdocs/Metadata/Type.hpp>
+#include <mrdocs/Support/NodePool.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
 #include <optional>
 #include <string>
@@ -37,6 +38,7 @@ enum class TArgKind : int
 MRDOCS_DECL std::string_view toString(TArgKind kind) noexcept;
 
 struct TArg
+    : PoolAllocated
 {
     /** The kind of template argument this is. */
     TArgKind Kind;
@@ -148,6 +150,7 @@ enum class TParamKind : int
 MRDOCS_DECL std::string_view toString(TParamKind kind) noexcept;
 
 struct TParam
+    : PoolAllocated
 {
     /** The kind of template parameter this is */
     TParamKind Kind;
@@ -17,6 +17,7 @@
 #include <mrdocs/Metadata/Specifiers.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
 #include <mrdocs/MetadataFwd.hpp>
+#include <mrdocs/Support/NodePool.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
 #include <memory>
 #include <string>
@@ -59,6 +60,7 @@ enum class AutoKind
 MRDOCS_DECL dom::String toString(AutoKind kind) noexcept;
 
 struct TypeInfo
+    : PoolAllocated
 {
     /** The kind of TypeInfo this is
     */
@@ -46,6 +46,7 @@ struct Location;
 struct NameInfo;
 struct Param;
 struct SpecializationNameInfo;
+struct SourceFile;
 struct SourceInfo;
 struct TypeInfo;
 struct VerbatimBlock;
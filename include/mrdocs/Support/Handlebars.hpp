@@ -16,6 +16,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <vector>
 #include <variant>
@@ -158,6 +159,8 @@ namespace detail {
 
     struct RenderState;
 
+    struct CompiledTemplate;
+
     // Heterogeneous lookup support
     struct string_hash {
         using is_transparent [[maybe_unused]] = void;
@@ -172,9 +175,6 @@ namespace detail {
         }
     };
 
-    using partials_map = std::unordered_map<
-        std::string, std::string, string_hash, std::equal_to<>>;
-
     using partials_view_map = std::unordered_map<
         std::string, std::string_view, string_hash, std::equal_to<>>;
 }
@@ -339,6 +339,60 @@ public:
     }
 };
 
+/** A compiled handlebars template
+
+    This class represents a handlebars template that has been
+    compiled with @ref Handlebars::compile.
+
+    A compiled template owns a copy of the template text and the
+    parsed representation of its tags and blocks. Rendering a
+    compiled template does not need to find and parse the tags
+    in the template text again, which makes it the preferred
+    representation for templates that are rendered many times.
+
+    The compiled representation is immutable and independent of the
+    helpers and partials registered in the environment, so copies of
+    the same compiled template can be shared and rendered
+    concurrently from multiple threads.
+
+    @code{.cpp}
+      Handlebars env;
+      HandlebarsTemplate tmpl = env.compile("{{ foo }}");
+      dom::Object context;
+      context["foo"] = "bar";
+      std::string result = env.render(tmpl, context);
+      assert(result == "bar");
+    @endcode
+
+    @see Handlebars::compile
+ */
+class MRDOCS_DECL HandlebarsTemplate
+{
+    friend class Handlebars;
+
+    std::shared_ptr<detail::CompiledTemplate const> impl_;
+
+public:
+    /** Constructor
+
+        Construct an empty template.
+     */
+    HandlebarsTemplate() noexcept = default;
+
+    /** Return the template text
+     */
+    std::string_view
+    text() const noexcept;
+
+    /** Return true if the template is empty
+     */
+    bool
+    empty() const noexcept
+    {
+        return !impl_;
+    }
+};
+
 /** A handlebars environment
 
     This class implements a handlebars template environment.
@@ -410,27 +464,26 @@ public:
 
     Compiled templates:
 
-    Unlike handlebars.js, this implementation renders the template
-    directly to the output stream, without requiring an intermediary
-    object to store a representation of the compiled template
-    (`Handlebars.precompile`) or an intermediary callable object
-    required to ultimately render the template (`Handlebars.precompile`).
-
-    The rationale is that there is not much benefit in pre-compiling templates
-    in C++, since both iterating the input string and a pre-compiled template
-    would have very similar costs even in optimal implementations of the
-    compiled template.
+    Templates can be rendered directly from the input string, as
+    in the examples above. In this case, the tags in the template
+    are identified and parsed as the template is rendered.
 
-    The most significant benefit of pre-compiling templates in C++ would
-    be the faster identification of the ends of blocks, which would
-    allow the engine iterate the block only once. For this reason,
-    compiled templates will still be considered in a future version
-    of this sub-library.
+    Templates that are rendered many times can be compiled
+    with `compile` into a @ref HandlebarsTemplate, which stores
+    the parsed tags and the extents of each block. Rendering a
+    compiled template skips the identification and parsing
+    of tags and blocks, which would otherwise be repeated every time
+    the template is rendered, and every time a block helper such as
+    `each` renders its block. Partials registered with
+    `registerPartial` are always compiled.
 
-    Also note that compiled templates cannot avoid exceptions, because
+    Compiled templates cannot avoid exceptions, because
     a compiled template can still invoke a helper that throws exceptions
     and evaluate dynamic expressions that cannot be identified during the
-    first pass.
+    first pass. For the same reason, helpers and partials are still
+    resolved by name when the template is rendered, so that the
+    compiled template remains valid when helpers and partials
+    are registered after the template is compiled.
 
     Incremental rendering and compilation:
 
@@ -485,7 +538,9 @@ class Handlebars {
     using helpers_map = std::unordered_map<
         std::string, dom::Function, detail::string_hash, std::equal_to<>>;
 
-    using partials_map = detail::partials_map;
+    using partials_map = std::unordered_map<
+        std::string, HandlebarsTemplate, detail::string_hash, std::equal_to<>>;
+
     partials_map partials_;
     helpers_map helpers_;
     dom::Function logger_;
@@ -690,6 +745,137 @@ public:
         return try_render_to(out, templateText, context, {});
     }
 
+    /** Compile a handlebars template
+
+        This function identifies and parses all tags and blocks
+        in the specified template text and returns a compiled
+        template that can be rendered many times with `render`,
+        `render_to`, `try_render` and `try_render_to`.
+
+        The compiled template owns a copy of the template text,
+        so the text does not need to outlive the compiled template.
+
+        Compilation never fails: invalid tags and blocks are rendered
+        or reported exactly as they would be when rendering the
+        template text directly.
+
+        Because the compiled template does not depend on the
+        helpers and partials registered in the environment, a
+        template can be compiled once and rendered by any number
+        of environments.
+
+        @param templateText The handlebars template text
+        @return The compiled template
+     */
+    static
+    HandlebarsTemplate
+    compile(std::string_view templateText);
+
+    /** Render a compiled handlebars template
+
+        This function renders the specified compiled template and
+        returns the result as a string.
+
+        @param tmpl The compiled template
+        @param context The data to render
+        @param options The options to use
+        @return The rendered text
+     */
+    std::string
+    render(
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        auto exp = try_render(tmpl, context, options);
+        if (!exp)
+        {
+            throw exp.error();
+        }
+        return *exp;
+    }
+
+    /// @overload
+    std::string
+    render(
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context) const
+    {
+        return render(tmpl, context, {});
+    }
+
+    /** Render a compiled handlebars template
+
+        This function renders the specified compiled template and
+        writes the result to the specified output stream.
+
+        @param out The output stream
+        @param tmpl The compiled template
+        @param context The data to render
+        @param options The options to use
+     */
+    void
+    render_to(
+        OutputRef& out,
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        auto exp = try_render_to(out, tmpl, context, options);
+        if (!exp)
+        {
+            throw exp.error();
+        }
+    }
+
+    /// @overload
+    void
+    render_to(
+        OutputRef& out,
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context) const
+    {
+        render_to(out, tmpl, context, {});
+    }
+
+    /** Render a compiled handlebars template
+
+        @param tmpl The compiled template
+        @param context The data to render
+        @param options The options to use
+        @return The rendered text or an error
+     */
+    Expected<std::string, HandlebarsError>
+    try_render(
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        std::string out;
+        OutputRef os(out);
+        auto exp = try_render_to(os, tmpl, context, options);
+        if (!exp)
+        {
+            return Unexpected(exp.error());
+        }
+        return out;
+    }
+
+    /** Render a compiled handlebars template
+
+        @param out The output stream
+        @param tmpl The compiled template
+        @param context The data to render
+        @param options The options to use
+        @return An error if the template could not be rendered
+     */
+    Expected<void, HandlebarsError>
+    try_render_to(
+        OutputRef& out,
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const;
+
     /** Register a partial
 
         This function registers a partial with the handlebars environment.
@@ -713,6 +899,9 @@ public:
         </ul>
         @endcode
 
+        The partial is compiled when it is registered, so its tags
+        are not parsed again every time the partial is rendered.
+
         @param name The name of the partial
         @param text The content of the partial
 
@@ -722,6 +911,18 @@ public:
     void
     registerPartial(std::string_view name, std::string_view text);
 
+    /** Register a partial that is already compiled
+
+        The compiled template is shared, not copied, so the same
+        partial can be registered with several environments
+        without parsing its text again.
+
+        @param name The name of the partial
+        @param tmpl The compiled partial
+     */
+    void
+    registerPartial(std::string_view name, HandlebarsTemplate tmpl);
+
     /** Unregister a partial
 
         This function unregisters a partial with the handlebars environment.
@@ -880,7 +1081,8 @@ private:
     std::pair<std::string_view, bool>
     getPartial(
         std::string_view name,
-        detail::RenderState const& state) const;
+        detail::RenderState const& state,
+        detail::CompiledTemplate const*& compiled) const;
 };
 
 /** Determine if a value is empty
@@ -324,6 +324,30 @@ public:
     Expected<Value>
     compile_function(std::string_view jsCode);
 
+    /** Return the bytecode of a compiled function.
+
+        The bytecode can be loaded into any other
+        context with `load_function()`, which is
+        much cheaper than compiling the source code
+        of the function again.
+
+        Only functions compiled from source code
+        can be dumped. Native functions and bound
+        functions return an error.
+    */
+    MRDOCS_DECL
+    Expected<std::string>
+    dump_function(Value const& fn);
+
+    /** Load a function from its bytecode.
+
+        The bytecode must have been produced by
+        `dump_function()` in the same program.
+    */
+    MRDOCS_DECL
+    Expected<Value>
+    load_function(std::string_view bytecode);
+
     /** Return a global object if it exists.
 
         This function returns a @ref Value that
@@ -1026,6 +1050,32 @@ registerHelper(
     Context& ctx,
     std::string_view script);
 
+/** Compile a JavaScript helper function to bytecode
+
+    The returned bytecode can be registered with
+    any number of contexts by `registerCompiledHelper`,
+    so that the source code of the helper is only
+    compiled once.
+ */
+MRDOCS_DECL
+Expected<std::string, Error>
+compileHelper(std::string_view script);
+
+/** Register a compiled JavaScript helper function
+
+    This function registers a JavaScript function,
+    compiled by `compileHelper`, as a helper
+    function that can be called from Handlebars
+    templates.
+ */
+MRDOCS_DECL
+Expected<void, Error>
+registerCompiledHelper(
+    clang::mrdocs::Handlebars& hbs,
+    std::string_view name,
+    Context& ctx,
+    std::string_view bytecode);
+
 } // js
 } // mrdocs
 } // clang
@@ -0,0 +1,89 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_API_SUPPORT_NODEPOOL_HPP
+#define MRDOCS_API_SUPPORT_NODEPOOL_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <cstddef>
+
+namespace clang {
+namespace mrdocs {
+
+/** Allocate memory for a metadata node.
+
+    Small nodes are carved from large blocks
+    owned by the calling thread, and freed nodes
+    are kept in per-thread lists for reuse, so
+    neither allocation nor deallocation calls
+    into the global heap in the common case.
+    Larger nodes use the global operator new.
+
+    A thread gives its free nodes back to a
+    shared depot in batches, and everything it
+    holds when it exits, so nodes freed by
+    another thread or held by a thread which
+    exited are reused by the other threads.
+
+    The memory of the blocks is never returned
+    to the system, and lives until the program
+    exits.
+
+    @param size The size of the node.
+*/
+MRDOCS_DECL
+void*
+allocateNode(std::size_t size);
+
+/** Deallocate memory returned by @ref allocateNode.
+
+    The memory can be deallocated by any thread.
+
+    @param p The memory.
+    @param size The size passed to @ref allocateNode.
+*/
+MRDOCS_DECL
+void
+deallocateNode(void* p, std::size_t size) noexcept;
+
+/** Base class for metadata nodes allocated from the node pool.
+
+    A class derived from this one is allocated
+    with @ref allocateNode by `new`, including
+    through `std::make_unique`, and is released
+    to the pool by `delete`, including through
+    `std::unique_ptr`. The base must have a
+    virtual destructor, so that the size of the
+    most derived object is deallocated.
+*/
+struct PoolAllocated
+{
+    static
+    void*
+    operator new(std::size_t size)
+    {
+        return allocateNode(size);
+    }
+
+    static
+    void
+    operator delete(void* p, std::size_t size) noexcept
+    {
+        deallocateNode(p, size);
+    }
+
+    // so derived classes can default their comparisons
+    constexpr
+    bool
+    operator==(PoolAllocated const&) const noexcept = default;
+};
+
+} // mrdocs
+} // clang
+
+#endif
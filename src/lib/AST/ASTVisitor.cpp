@@ -18,7 +18,9 @@
 #include "lib/Support/Glob.hpp"
 #include "lib/Lib/Diagnostics.hpp"
 #include "lib/Lib/Filters.hpp"
+#include "lib/Lib/HeaderDeclRegistry.hpp"
 #include "lib/Lib/Info.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <clang/AST/AST.h>
 #include <clang/AST/Attr.h>
@@ -28,23 +30,31 @@
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Index/USRGeneration.h>
 #include <clang/Lex/Lexer.h>
+#include <clang/Lex/MacroInfo.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
 #include <clang/Parse/ParseAST.h>
 #include <clang/Sema/Lookup.h>
 #include <clang/Sema/Sema.h>
 #include <clang/Sema/Template.h>
 #include <clang/Sema/SemaConsumer.h>
 #include <clang/Sema/TemplateInstCallback.h>
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SHA1.h>
+#include <llvm/Support/xxhash.h>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace clang {
 namespace mrdocs {
@@ -156,6 +166,161 @@ static const Expr *SubstituteConstraintExpressionWithoutSatisfaction(
   return SubstConstr.get();
 }
 
+//------------------------------------------------
+//
+// HeaderMacroCallbacks
+//
+//------------------------------------------------
+
+/** Records the macros consulted by each file.
+
+    A header declares different things when the
+    macros it tests or expands are defined
+    differently before it is included. The macros
+    consulted in a file are recorded along with
+    their definitions, and their hash is part of
+    the registry key of the declarations of the file.
+*/
+class HeaderMacroCallbacks
+    : public PPCallbacks
+{
+    Preprocessor& PP_;
+    SourceManager& source_;
+    llvm::DenseMap<MacroInfo const*, std::uint64_t> definitions_;
+    llvm::DenseMap<FileID, std::unordered_set<std::uint64_t>> consulted_;
+
+    std::uint64_t
+    hashDefinition(MacroInfo const* MI)
+    {
+        if(! MI)
+            return 0;
+        auto [it, created] = definitions_.try_emplace(MI, 0);
+        if(! created)
+            return it->second;
+        std::string s;
+        s.push_back(MI->isBuiltinMacro() ? 'b' :
+            MI->isFunctionLike() ? 'f' : 'o');
+        if(MI->isVariadic())
+            s.push_back('v');
+        for(IdentifierInfo const* param : MI->params())
+        {
+            s.append(param->getName());
+            s.push_back(',');
+        }
+        llvm::SmallString<32> buffer;
+        for(Token const& tok : MI->tokens())
+        {
+            s.push_back(' ');
+            s.append(PP_.getSpelling(tok, buffer));
+        }
+        it->second = llvm::xxHash64(s) | 1;
+        return it->second;
+    }
+
+    void
+    record(
+        SourceLocation loc,
+        Token const& name,
+        MacroDefinition const& MD)
+    {
+        IdentifierInfo const* II = name.getIdentifierInfo();
+        if(! II || loc.isInvalid())
+            return;
+        FileID const FID = source_.getFileID(
+            source_.getExpansionLoc(loc));
+        if(FID.isInvalid() || FID == source_.getMainFileID())
+            return;
+        std::uint64_t const hashes[] = {
+            llvm::xxHash64(II->getName()),
+            hashDefinition(MD.getMacroInfo()) };
+        consulted_[FID].insert(llvm::xxHash64(llvm::ArrayRef<std::uint8_t>(
+            reinterpret_cast<std::uint8_t const*>(hashes),
+            sizeof(hashes))));
+    }
+
+public:
+    explicit
+    HeaderMacroCallbacks(Preprocessor& PP) noexcept
+        : PP_(PP)
+        , source_(PP.getSourceManager())
+    {
+    }
+
+    /** Return the hash of the macros consulted in a file.
+    */
+    std::uint64_t
+    hash(FileID FID) const
+    {
+        auto it = consulted_.find(FID);
+        if(it == consulted_.end())
+            return 0;
+        // the order in which the macros
+        // were consulted does not matter
+        std::uint64_t h = 0;
+        for(std::uint64_t macro : it->second)
+            h ^= macro;
+        return h;
+    }
+
+    void
+    MacroExpands(
+        Token const& name,
+        MacroDefinition const& MD,
+        SourceRange,
+        MacroArgs const*) override
+    {
+        record(name.getLocation(), name, MD);
+    }
+
+    void
+    Defined(
+        Token const& name,
+        MacroDefinition const& MD,
+        SourceRange) override
+    {
+        record(name.getLocation(), name, MD);
+    }
+
+    void
+    Ifdef(
+        SourceLocation loc,
+        Token const& name,
+        MacroDefinition const& MD) override
+    {
+        record(loc, name, MD);
+    }
+
+    void
+    Ifndef(
+        SourceLocation loc,
+        Token const& name,
+        MacroDefinition const& MD) override
+    {
+        record(loc, name, MD);
+    }
+
+    using PPCallbacks::Elifdef;
+    using PPCallbacks::Elifndef;
+
+    void
+    Elifdef(
+        SourceLocation loc,
+        Token const& name,
+        MacroDefinition const& MD) override
+    {
+        record(loc, name, MD);
+    }
+
+    void
+    Elifndef(
+        SourceLocation loc,
+        Token const& name,
+        MacroDefinition const& MD) override
+    {
+        record(loc, name, MD);
+    }
+};
+
 //------------------------------------------------
 //
 // ASTVisitor
@@ -193,17 +358,47 @@ public:
         std::string full_path;
         std::string_view short_path;
         FileKind kind;
+
+        // whether the file matches the input
+        // include prefixes and file patterns
+        bool matches_input = true;
+
+        // the interned file, created on first use
+        SourceFile const* source = nullptr;
     };
 
     std::unordered_map<
         const FileEntry*,
         FileInfo> files_;
 
+    // the file of each FileID, indexed by its hash value,
+    // resolved on first use. loaded FileIDs, such as
+    // those of a precompiled preamble, are negative.
+    std::vector<std::optional<FileInfo*>> localFileIDs_;
+    std::vector<std::optional<FileInfo*>> loadedFileIDs_;
+
     llvm::SmallString<128> usr_;
     ODRHash odr_hash_;
 
     SymbolFilter symbolFilter_;
 
+    // declarations other translation units
+    // already extracted from the same headers
+    HeaderDeclRegistry* headerDecls_;
+    HeaderMacroCallbacks const* headerMacros_;
+    std::vector<HeaderDeclRegistry::Key> extractedHeaderDecls_;
+    std::unordered_set<SymbolID> skippedHeaderDecls_;
+    llvm::DenseMap<FileID, std::uint64_t> headerHashes_;
+    std::uint64_t predefinesHash_ = 0;
+
+    // time spent visiting the declarations of each file,
+    // recorded when the build is profiled
+    using clock_type = std::chrono::steady_clock;
+    bool profileFiles_;
+    llvm::DenseMap<FileEntry const*, clock_type::duration> fileTimes_;
+    FileEntry const* currentFile_ = nullptr;
+    clock_type::time_point checkpoint_;
+
     enum class ExtractMode
     {
         // extraction of declarations which pass all filters
@@ -255,7 +450,10 @@ public:
         Diagnostics& diags,
         CompilerInstance& compiler,
         ASTContext& context,
-        Sema& sema) noexcept
+        Sema& sema,
+        HeaderDeclRegistry* headerDecls,
+        HeaderMacroCallbacks const* headerMacros,
+        bool profileFiles) noexcept
         : config_(config)
         , diags_(diags)
         , compiler_(compiler)
@@ -263,6 +461,9 @@ public:
         , source_(context.getSourceManager())
         , sema_(sema)
         , symbolFilter_(config->symbolFilter)
+        , headerDecls_(headerDecls)
+        , headerMacros_(headerMacros)
+        , profileFiles_(profileFiles)
     {
         // install handlers for our custom commands
         initCustomCommentCommands(context_);
@@ -322,10 +523,13 @@ public:
             // if an empty string is returned
             std::string_view file_path =
                 file->tryGetRealPathName();
-            files_.emplace(file,
+            auto [it, created] = files_.emplace(file,
                 getFileInfo(search_dirs,
                     normalize_path(file_path),
                     sourceRoot));
+            if(created)
+                it->second.matches_input =
+                    config_->inputFilter.match(it->second.full_path);
         };
 
         // build the file info for the main file
@@ -336,6 +540,8 @@ public:
         // build the file info for all included files
         for(const FileEntry* file : PP.getIncludedFiles())
             build_file_info(file);
+
+        localFileIDs_.resize(source_.local_sloc_entry_size());
     }
 
     FileInfo
@@ -411,6 +617,56 @@ public:
         return info_;
     }
 
+    /** Return the header declarations extracted by this translation unit.
+    */
+    std::span<HeaderDeclRegistry::Key const>
+    extractedHeaderDecls() const noexcept
+    {
+        return extractedHeaderDecls_;
+    }
+
+    /** Return the number of header declarations which were skipped.
+    */
+    std::size_t
+    skippedHeaderDecls() const noexcept
+    {
+        return skippedHeaderDecls_.size();
+    }
+
+    /** Return the time spent visiting the declarations of each file.
+
+        The time is only recorded when the build
+        is profiled.
+    */
+    std::vector<std::pair<std::string, clock_type::duration>>
+    fileTimes() const
+    {
+        std::vector<std::pair<std::string, clock_type::duration>> result;
+        result.reserve(fileTimes_.size());
+        for(auto const& [file, time] : fileTimes_)
+        {
+            auto it = files_.find(file);
+            result.emplace_back(it != files_.end() ?
+                it->second.full_path :
+                std::string(file->tryGetRealPathName()), time);
+        }
+        return result;
+    }
+
+    /** Attribute the time since the last switch to the current file.
+
+        @return The previous current file.
+    */
+    FileEntry const*
+    switchFile(FileEntry const* file)
+    {
+        auto const now = clock_type::now();
+        if(currentFile_)
+            fileTimes_[currentFile_] += now - checkpoint_;
+        checkpoint_ = now;
+        return std::exchange(currentFile_, file);
+    }
+
     void build()
     {
         // traverse the translation unit, only extracting
@@ -424,14 +680,22 @@ public:
         // if dependency extraction is disabled, we are done
         if(config_->referencedDeclarations ==
             ConfigImpl::SettingsImpl::ExtractPolicy::Never)
+        {
+            if(profileFiles_)
+                switchFile(nullptr);
             return;
+        }
 
         // traverse the current set of dependencies,
         // and generate a new set based on the results.
         // if the new set is non-empty, perform another pass.
         // do this until no new dependencies are generated
+        trace::Span span("Extract dependencies");
         std::unordered_set<Decl*> previous;
         buildDependencies(previous);
+
+        if(profileFiles_)
+            switchFile(nullptr);
     }
 
     void buildDependencies(
@@ -448,7 +712,8 @@ public:
             // skip declarations which generate invalid symbol IDs,
             // or which already have been extract
             if(SymbolID id = extractSymbolID(D);
-                ! id || info_.contains(id))
+                ! id || info_.contains(id) ||
+                skippedHeaderDecls_.contains(id))
                 continue;
             traverseDecl(D);
         }
@@ -460,6 +725,75 @@ public:
 
     //------------------------------------------------
 
+    /** Return the registry key of a declaration in a header
+
+        Only declarations at namespace scope which are
+        extracted normally are registered. Their members
+        are skipped along with them.
+
+        @return The key, or `std::nullopt` if the
+        declaration is not in a header or should
+        not be registered.
+     */
+    std::optional<HeaderDeclRegistry::Key>
+    getHeaderDeclKey(Decl* D)
+    {
+        if(! headerDecls_ ||
+            currentMode() != ExtractMode::Normal ||
+            ! isa<TagDecl, FunctionDecl, VarDecl,
+                TypedefNameDecl, ConceptDecl>(D) ||
+            ! D->getDeclContext()->isFileContext())
+            return std::nullopt;
+
+        FileID FID = source_.getFileID(
+            source_.getExpansionLoc(D->getLocation()));
+        if(FID.isInvalid() || FID == source_.getMainFileID())
+            return std::nullopt;
+
+        HeaderDeclRegistry::Key key;
+        if(! extractSymbolID(D, key.id))
+            return std::nullopt;
+
+        // the same header can declare different things
+        // when the predefined macros, or the macros it
+        // consults, are defined differently
+        auto [it, created] = headerHashes_.try_emplace(FID, 0);
+        if(created)
+        {
+            std::optional<llvm::StringRef> buffer =
+                source_.getBufferDataOrNone(FID);
+            if(! predefinesHash_)
+                predefinesHash_ = llvm::xxHash64(
+                    sema_.getPreprocessor().getPredefines());
+            std::uint64_t const hashes[] = {
+                buffer ? llvm::xxHash64(*buffer) : 0,
+                predefinesHash_,
+                getHeaderMacroHash(FID) };
+            it->second = llvm::xxHash64(llvm::ArrayRef<std::uint8_t>(
+                reinterpret_cast<std::uint8_t const*>(hashes),
+                sizeof(hashes)));
+        }
+        key.file = it->second;
+        return key;
+    }
+
+    /** Return the hash of the macros consulted by a header
+
+        The headers included by a precompiled preamble
+        are not preprocessed again, so the macros they
+        consult are not observed. Their macros are the
+        same in the translation units which share the
+        preamble, so the preamble is hashed instead.
+     */
+    std::uint64_t
+    getHeaderMacroHash(FileID FID) const
+    {
+        if(source_.isLoadedFileID(FID))
+            return llvm::xxHash64(
+                compiler_.getPreprocessorOpts().ImplicitPCHInclude) | 1;
+        return headerMacros_ ? headerMacros_->hash(FID) : 0;
+    }
+
     /** Get Info from ASTVisitor InfoSet
      */
     Info*
@@ -838,15 +1172,31 @@ public:
     // type named "SourceLocation"...
     FileInfo* getFileInfo(clang::SourceLocation loc)
     {
-        // KRYSTIAN FIXME: we really should not be
-        // calling getPresumedLoc this often,
-        // it's quite expensive
-        auto presumed = source_.getPresumedLoc(loc, false);
-        if(presumed.isInvalid())
+        // line directives are not used, so the presumed
+        // file is the file of the expansion location
+        if(loc.isInvalid())
             return nullptr;
+        return getFileInfo(source_.getFileID(
+            source_.getExpansionLoc(loc)));
+    }
+
+    FileInfo* getFileInfo(FileID id)
+    {
+        int const value = static_cast<int>(id.getHashValue());
+        auto& cache = value >= 0 ? localFileIDs_ : loadedFileIDs_;
+        std::size_t const index = value >= 0 ? value : -(value + 1);
+        if(index >= cache.size())
+            cache.resize(index + 1);
+        std::optional<FileInfo*>& file = cache[index];
+        if(! file)
+            file = lookupFileInfo(id);
+        return *file;
+    }
+
+    FileInfo* lookupFileInfo(FileID id)
+    {
         const FileEntry* file =
-            source_.getFileEntryForID(
-                presumed.getFileID());
+            source_.getFileEntryForID(id);
         // KRYSTIAN NOTE: i have no idea under what
         // circumstances the file entry would be null
         if(! file)
@@ -877,31 +1227,31 @@ public:
         bool definition,
         bool documented)
     {
-        unsigned line = source_.getPresumedLoc(
-            loc, false).getLine();
-        FileInfo* file = getFileInfo(loc);
+        auto [id, offset] = source_.getDecomposedExpansionLoc(loc);
+        FileInfo* file = getFileInfo(id);
         MRDOCS_ASSERT(file);
+        unsigned line = source_.getLineNumber(id, offset);
+        if(! file->source)
+            file->source = &internSourceFile(
+                file->full_path, file->short_path, file->kind);
+        SourceFile const* source = file->source;
         if(definition)
         {
             if(I.DefLoc)
                 return;
-            I.DefLoc.emplace(file->full_path,
-                file->short_path, line, file->kind,
-                documented);
+            I.DefLoc.emplace(*source, line, documented);
         }
         else
         {
             auto existing = std::find_if(I.Loc.begin(), I.Loc.end(),
-                [line, file](const Location& l)
+                [line, source](const Location& l)
                 {
                     return l.LineNumber == line &&
-                        l.Path == file->full_path;
+                        l.path() == source->Path;
                 });
             if(existing != I.Loc.end())
                 return;
-            I.Loc.emplace_back(file->full_path,
-                file->short_path, line, file->kind,
-                documented);
+            I.Loc.emplace_back(*source, line, documented);
         }
     }
 
@@ -1519,42 +1869,12 @@ public:
                 return false;
         }
 
-        if (!config_->input.include.empty())
+        if (!config_->inputFilter.empty())
         {
-            // Get filename
+            // the filters are checked once per file
             FileInfo* file = getFileInfo(D->getBeginLoc());
-            if (!file)
+            if (!file || !file->matches_input)
                 return false;
-            std::string filename = file->full_path;
-            bool matchPrefix = std::ranges::any_of(
-                config_->input.include,
-                [&filename](const std::string& prefix)
-                {
-                    return files::startsWith(filename, prefix);
-                });
-            if (!matchPrefix)
-            {
-                return false;
-            }
-        }
-
-        if (!config_->input.filePatterns.empty())
-        {
-            // Get filename
-            FileInfo* file = getFileInfo(D->getBeginLoc());
-            if (!file)
-                return false;
-            std::string filename = file->full_path;
-            bool matchPattern = std::ranges::any_of(
-                config_->input.filePatterns,
-                [&filename](const std::string& pattern)
-                {
-                    return globMatch(pattern, filename);
-                });
-            if (!matchPattern)
-            {
-                return false;
-            }
         }
 
     #if 0
@@ -3353,8 +3673,30 @@ traverseDecl(
     if(D->isInvalidDecl() || D->isImplicit())
         return;
 
+    // Skip declarations which another translation
+    // unit already extracted from the same header
+    std::optional<HeaderDeclRegistry::Key> headerKey =
+        getHeaderDeclKey(D);
+    if(headerKey && headerDecls_->contains(*headerKey))
+    {
+        skippedHeaderDecls_.insert(headerKey->id);
+        return;
+    }
+
     SymbolFilter::FilterScope scope(symbolFilter_);
 
+    // Attribute the time spent on declarations at
+    // namespace scope to the file they are written in
+    bool const timed = profileFiles_ &&
+        D->getDeclContext() &&
+        D->getDeclContext()->isFileContext();
+    FileEntry const* previousFile = nullptr;
+    if(timed)
+    {
+        previousFile = switchFile(source_.getFileEntryForID(
+            source_.getFileID(source_.getExpansionLoc(D->getLocation()))));
+    }
+
     // Convert to the most derived type of the Decl
     // and call the appropriate traverse function
     visit(D, [&]<typename DeclTy>(DeclTy* DD)
@@ -3389,6 +3731,12 @@ traverseDecl(
             traverse(DD, std::forward<Args>(args)...);
         }
     });
+
+    if(timed)
+        switchFile(previousFile);
+
+    if(headerKey && info_.contains(headerKey->id))
+        extractedHeaderDecls_.push_back(*headerKey);
 }
 
 void
@@ -4559,8 +4907,17 @@ class ASTVisitorConsumer
     const ConfigImpl& config_;
     ExecutionContext& ex_;
     CompilerInstance& compiler_;
+    HeaderMacroCallbacks const* headerMacros_;
 
     Sema* sema_ = nullptr;
+    std::chrono::steady_clock::time_point start_;
+
+    void
+    Initialize(ASTContext&) override
+    {
+        // called before the translation unit is parsed
+        start_ = std::chrono::steady_clock::now();
+    }
 
     void
     InitializeSema(Sema& S) override
@@ -4606,21 +4963,72 @@ class ASTVisitorConsumer
         // skip the translation unit if configured to do so
         convert_to_slash(*file_name);
 
+        HeaderDeclRegistry* headerDecls = ex_.headerDecls();
+        BuildProfile* profile = ex_.profile();
+
         ASTVisitor visitor(
             config_,
             diags,
             compiler_,
             Context,
-            *sema_);
+            *sema_,
+            headerDecls,
+            headerMacros_,
+            profile != nullptr);
 
         // Traverse the translation unit
+        trace::Span span("Visit AST");
         visitor.build();
+        span.arg("infos", static_cast<std::int64_t>(visitor.results().size()));
+        span.end();
+
+        // Let the translation units processed later skip
+        // the declarations extracted from the headers
+        if(headerDecls)
+        {
+            headerDecls->insert(visitor.extractedHeaderDecls());
+            headerDecls->addBuilt(visitor.extractedHeaderDecls().size());
+            headerDecls->addSkipped(visitor.skippedHeaderDecls());
+        }
+
+        // Report the files the results depend on
+        std::vector<std::string> dependencies;
+        auto addDependency = [&](FileEntry const* file)
+        {
+            // an empty path is reported too, so the
+            // results are known to be incomplete
+            if(file)
+                dependencies.emplace_back(file->tryGetRealPathName());
+        };
+        addDependency(source.getFileEntryForID(source.getMainFileID()));
+        for(FileEntry const* file : compiler_.getPreprocessor().getIncludedFiles())
+            addDependency(file);
+        ex_.reportDependencies(std::move(dependencies));
 
         // VFALCO If we returned from the function early
         // then this line won't execute, which means we
         // will miss error and warnings emitted before
         // the return.
         ex_.report(std::move(visitor.results()), std::move(diags));
+
+        // Record the cost of the translation unit. The memory
+        // allocated by clang is only released when the
+        // translation unit is done, so this is its peak.
+        if(profile)
+        {
+            Preprocessor& PP = compiler_.getPreprocessor();
+            std::size_t memory =
+                Context.getASTAllocatedMemory() +
+                Context.getSideTableAllocatedMemory() +
+                PP.getTotalMemory() +
+                source.getDataStructureSizes() +
+                source.getMemoryBufferSizes().malloc_bytes;
+            profile->add({
+                std::string(file_name->str()),
+                std::chrono::steady_clock::now() - start_,
+                memory},
+                visitor.fileTimes());
+        }
     }
 
     /** Skip function bodies
@@ -4682,10 +5090,12 @@ public:
     ASTVisitorConsumer(
         const ConfigImpl& config,
         ExecutionContext& ex,
-        CompilerInstance& compiler) noexcept
+        CompilerInstance& compiler,
+        HeaderMacroCallbacks const* headerMacros) noexcept
         : config_(config)
         , ex_(ex)
         , compiler_(compiler)
+        , headerMacros_(headerMacros)
     {
     }
 };
@@ -4747,6 +5157,7 @@ struct ASTAction
             CI.createSema(getTranslationUnitKind(), nullptr);
         }
 
+        trace::Span span("Parse");
         ParseAST(
             CI.getSema(),
             false, // ShowStats
@@ -4771,8 +5182,18 @@ struct ASTAction
         clang::CompilerInstance& Compiler,
         llvm::StringRef InFile) override
     {
+        // The macros consulted by the headers are only
+        // needed to skip the declarations of headers
+        HeaderMacroCallbacks* headerMacros = nullptr;
+        if (ex_.headerDecls() && Compiler.hasPreprocessor())
+        {
+            auto callbacks = std::make_unique<HeaderMacroCallbacks>(
+                Compiler.getPreprocessor());
+            headerMacros = callbacks.get();
+            Compiler.getPreprocessor().addPPCallbacks(std::move(callbacks));
+        }
         return std::make_unique<ASTVisitorConsumer>(
-            config_, ex_, Compiler);
+            config_, ex_, Compiler, headerMacros);
     }
 
 private:
@@ -4792,10 +5213,34 @@ struct ASTActionFactory :
 {
     ASTActionFactory(
         ExecutionContext& ex,
-        ConfigImpl const& config) noexcept
+        ConfigImpl const& config,
+        PreambleCache* preambles) noexcept
         : ex_(ex)
         , config_(config)
+        , preambles_(preambles)
+    {
+    }
+
+    /** Run the action on a translation unit
+
+        The invocation is changed to load a
+        precompiled preamble when one can be
+        used, before the action is run.
+    */
+    bool
+    runInvocation(
+        std::shared_ptr<CompilerInvocation> Invocation,
+        FileManager* Files,
+        std::shared_ptr<PCHContainerOperations> PCHContainerOps,
+        DiagnosticConsumer* DiagConsumer) override
     {
+        if (preambles_)
+        {
+            preambles_->apply(*Invocation, *Files, PCHContainerOps, ex_);
+        }
+        return tooling::FrontendActionFactory::runInvocation(
+            std::move(Invocation), Files,
+            std::move(PCHContainerOps), DiagConsumer);
     }
 
     std::unique_ptr<FrontendAction>
@@ -4807,6 +5252,7 @@ struct ASTActionFactory :
 private:
     ExecutionContext& ex_;
     ConfigImpl const& config_;
+    PreambleCache* preambles_;
 };
 
 } // (anon)
@@ -4816,9 +5262,10 @@ private:
 std::unique_ptr<tooling::FrontendActionFactory>
 makeFrontendActionFactory(
     ExecutionContext& ex,
-    ConfigImpl const& config)
+    ConfigImpl const& config,
+    PreambleCache* preambles)
 {
-    return std::make_unique<ASTActionFactory>(ex, config);
+    return std::make_unique<ASTActionFactory>(ex, config, preambles);
 }
 
 } // mrdocs
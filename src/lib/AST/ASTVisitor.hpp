@@ -13,6 +13,7 @@
 #ifndef MRDOCS_LIB_AST_ASTVISITOR_HPP
 #define MRDOCS_LIB_AST_ASTVISITOR_HPP
 
+#include "lib/AST/PreambleCache.hpp"
 #include "lib/Lib/ConfigImpl.hpp"
 #include "lib/Lib/ExecutionContext.hpp"
 #include <mrdocs/Platform.hpp>
@@ -22,11 +23,16 @@ namespace clang {
 namespace mrdocs {
 
 /** Return a factory used to create our visitor.
+
+    @param ex The execution context which receives the results.
+    @param config The configuration.
+    @param preambles The precompiled preambles to use, or null.
 */
 std::unique_ptr<tooling::FrontendActionFactory>
 makeFrontendActionFactory(
     ExecutionContext& ex,
-    ConfigImpl const& config);
+    ConfigImpl const& config,
+    PreambleCache* preambles = nullptr);
 
 } // mrdocs
 } // clang
@@ -0,0 +1,238 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "PreambleCache.hpp"
+#include "lib/Support/Chrono.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticIDs.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/Preprocessor.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Records the files included by a preamble
+class DependencyCallbacks
+    : public PreambleCallbacks
+{
+    std::vector<std::string>& files_;
+
+public:
+    explicit
+    DependencyCallbacks(
+        std::vector<std::string>& files) noexcept
+        : files_(files)
+    {
+    }
+
+    void
+    AfterExecute(CompilerInstance& CI) override
+    {
+        for (FileEntry const* file : CI.getPreprocessor().getIncludedFiles())
+        {
+            if (file)
+            {
+                files_.emplace_back(file->tryGetRealPathName());
+            }
+        }
+    }
+};
+
+std::string
+preambleKey(
+    CompilerInvocation const& invocation,
+    FileManager& files,
+    llvm::StringRef mainFile,
+    llvm::StringRef preamble)
+{
+    // The command line without the options which
+    // name the main file or the files derived from it
+    CompilerInvocation copy(invocation);
+    copy.getFrontendOpts().Inputs.clear();
+    copy.getFrontendOpts().OutputFile.clear();
+    CodeGenOptions& codeGen = copy.getCodeGenOpts();
+    codeGen.MainFileName.clear();
+    codeGen.DwarfDebugFlags.clear();
+    codeGen.RecordCommandLine.clear();
+    codeGen.CoverageDataFile.clear();
+    codeGen.CoverageNotesFile.clear();
+    codeGen.SplitDwarfFile.clear();
+    codeGen.SplitDwarfOutput.clear();
+    DependencyOutputOptions& dependencies = copy.getDependencyOutputOpts();
+    dependencies.OutputFile.clear();
+    dependencies.Targets.clear();
+    dependencies.HeaderIncludeOutputFile.clear();
+    dependencies.DOTOutputFile.clear();
+    copy.getDiagnosticOpts().DiagnosticSerializationFile.clear();
+
+    std::string s;
+    for (std::string const& arg : copy.getCC1CommandLine())
+    {
+        s.append(arg);
+        s.push_back('\0');
+    }
+    // Relative paths and quoted includes are
+    // resolved from these directories
+    if (auto cwd = files.getVirtualFileSystem().getCurrentWorkingDirectory())
+    {
+        s.append(*cwd);
+    }
+    s.push_back('\0');
+    s.append(llvm::sys::path::parent_path(mainFile));
+    s.push_back('\0');
+    s.append(preamble);
+    return llvm::toHex(llvm::SHA1::hash(
+        llvm::arrayRefFromStringRef(s)), true);
+}
+
+} // (anon)
+
+void
+PreambleCache::
+build(
+    Entry& entry,
+    CompilerInvocation const& invocation,
+    llvm::MemoryBuffer const& buffer,
+    PreambleBounds bounds,
+    FileManager& files,
+    std::shared_ptr<PCHContainerOperations> const& pchContainerOps)
+{
+    using clock_type = std::chrono::steady_clock;
+    auto const start = clock_type::now();
+
+    // Function bodies are skipped, as they
+    // are when the translation unit is parsed
+    CompilerInvocation preambleInvocation(invocation);
+    preambleInvocation.getFrontendOpts().SkipFunctionBodies = true;
+    preambleInvocation.getLangOpts().RetainCommentsFromSystemHeaders = true;
+
+    // Errors are reported when the
+    // translation unit itself is parsed
+    DiagnosticsEngine diags(
+        new DiagnosticIDs,
+        &preambleInvocation.getDiagnosticOpts(),
+        new IgnoringDiagConsumer);
+
+    DependencyCallbacks callbacks(entry.dependencies);
+    auto preamble = PrecompiledPreamble::Build(
+        preambleInvocation,
+        &buffer,
+        bounds,
+        diags,
+        &files.getVirtualFileSystem(),
+        pchContainerOps,
+        false, // StoreInMemory
+        "", // StoragePath
+        callbacks);
+    if (!preamble)
+    {
+        report::debug(
+            "Failed to precompile the preamble of \"{}\": {}",
+            buffer.getBufferIdentifier(), preamble.getError().message());
+        return;
+    }
+    entry.preamble.emplace(std::move(*preamble));
+    entry.buildTime = clock_type::now() - start;
+}
+
+void
+PreambleCache::
+apply(
+    CompilerInvocation& invocation,
+    FileManager& files,
+    std::shared_ptr<PCHContainerOperations> const& pchContainerOps,
+    ExecutionContext& ex)
+{
+    auto const& inputs = invocation.getFrontendOpts().Inputs;
+    if (inputs.size() != 1 || !inputs.front().isFile())
+    {
+        ++misses_;
+        return;
+    }
+    std::string const mainFile = inputs.front().getFile().str();
+    auto buffer = files.getBufferForFile(mainFile);
+    if (!buffer)
+    {
+        ++misses_;
+        return;
+    }
+    PreambleBounds const bounds = ComputePreambleBounds(
+        invocation.getLangOpts(), (*buffer)->getMemBufferRef(), 0);
+    if (bounds.Size == 0)
+    {
+        ++misses_;
+        return;
+    }
+
+    std::string const key = preambleKey(
+        invocation, files, mainFile,
+        (*buffer)->getBuffer().take_front(bounds.Size));
+    std::shared_ptr<Entry> entry;
+    std::size_t uses;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<Entry>& e = entries_[key];
+        if (!e)
+        {
+            e = std::make_shared<Entry>();
+        }
+        entry = e;
+        uses = ++entry->uses;
+    }
+    // The first translation unit is parsed
+    // normally, in case it is the only one
+    if (uses < 2)
+    {
+        ++misses_;
+        return;
+    }
+
+    std::call_once(entry->once, [&]
+    {
+        build(*entry, invocation, **buffer, bounds, files, pchContainerOps);
+        if (entry->preamble)
+        {
+            ++built_;
+        }
+    });
+    if (!entry->preamble ||
+        !entry->preamble->CanReuse(
+            invocation,
+            (*buffer)->getMemBufferRef(),
+            bounds,
+            files.getVirtualFileSystem()))
+    {
+        ++misses_;
+        return;
+    }
+
+    // The PCH is stored on disk, so the file
+    // system of the translation unit can read it
+    // and the overlay created here is not needed
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs =
+        &files.getVirtualFileSystem();
+    // The main file is remapped to the buffer,
+    // and the source manager takes ownership of it
+    entry->preamble->AddImplicitPreamble(invocation, fs, buffer->release());
+    ex.reportDependencies(entry->dependencies);
+
+    ++hits_;
+    saved_ += entry->buildTime / std::chrono::nanoseconds(1);
+    report::debug(
+        "Using the precompiled preamble of \"{}\", saved {}",
+        mainFile, format_duration(entry->buildTime));
+}
+
+} // mrdocs
+} // clang
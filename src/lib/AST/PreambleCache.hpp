@@ -0,0 +1,138 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_AST_PREAMBLECACHE_HPP
+#define MRDOCS_LIB_AST_PREAMBLECACHE_HPP
+
+#include "lib/Lib/ExecutionContext.hpp"
+#include <clang/Basic/FileManager.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/PrecompiledPreamble.h>
+#include <clang/Serialization/PCHContainerOperations.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** Precompiled preambles shared by translation units.
+
+    The preamble of a translation unit is the
+    leading block of preprocessor directives and
+    comments of its main file. Translation units
+    with the same preamble and the same compile
+    flags include the same headers, so the
+    preamble is precompiled once and the headers
+    are not parsed again for each of them.
+
+    Translation units are grouped by a hash of
+    their compile flags, working directory,
+    main file directory, and preamble. Since
+    precompiling a preamble costs more than
+    parsing it, a preamble is only precompiled
+    when a second translation unit uses it.
+
+    The cache can be used concurrently.
+*/
+class PreambleCache
+{
+    struct Entry
+    {
+        std::once_flag once;
+        std::size_t uses = 0;
+        std::optional<PrecompiledPreamble> preamble;
+        std::vector<std::string> dependencies;
+        std::chrono::steady_clock::duration buildTime{};
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+    std::atomic<std::size_t> built_ = 0;
+    std::atomic<std::int64_t> saved_ = 0;
+
+    static
+    void
+    build(
+        Entry& entry,
+        CompilerInvocation const& invocation,
+        llvm::MemoryBuffer const& buffer,
+        PreambleBounds bounds,
+        FileManager& files,
+        std::shared_ptr<PCHContainerOperations> const& pchContainerOps);
+
+public:
+    /** Use a precompiled preamble for a translation unit.
+
+        When a preamble can be used, the invocation
+        is changed to load it, and the files which
+        the preamble includes are reported to the
+        execution context.
+
+        @param invocation The invocation of the translation unit.
+        @param files The file manager of the translation unit.
+        @param pchContainerOps The operations used to read and write PCH files.
+        @param ex The execution context of the translation unit.
+    */
+    void
+    apply(
+        CompilerInvocation& invocation,
+        FileManager& files,
+        std::shared_ptr<PCHContainerOperations> const& pchContainerOps,
+        ExecutionContext& ex);
+
+    /** Return the number of translation units which used a preamble.
+    */
+    std::size_t
+    hits() const noexcept
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    /** Return the number of translation units which did not use a preamble.
+    */
+    std::size_t
+    misses() const noexcept
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    /** Return the number of preambles which were precompiled.
+    */
+    std::size_t
+    built() const noexcept
+    {
+        return built_.load(std::memory_order_relaxed);
+    }
+
+    /** Return the estimated parse time saved.
+
+        Each translation unit which used a preamble
+        saved about the time it took to precompile
+        the preamble.
+    */
+    std::chrono::nanoseconds
+    saved() const noexcept
+    {
+        return std::chrono::nanoseconds(
+            saved_.load(std::memory_order_relaxed));
+    }
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -11,7 +11,10 @@
 #include <mrdocs/Dom/Object.hpp>
 #include <mrdocs/Support/RangeFor.hpp>
 #include <fmt/format.h>
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <functional>
 #include <ranges>
 
 namespace clang {
@@ -129,14 +132,28 @@ ObjectImpl::exists(std::string_view key) const
 //
 //------------------------------------------------
 
+namespace {
+
+constexpr std::uint32_t empty_slot = std::uint32_t(-1);
+
+std::size_t
+hashKey(std::string_view key) noexcept
+{
+    return std::hash<std::string_view>()(key);
+}
+
+} // (anon)
+
 DefaultObjectImpl::
 DefaultObjectImpl() noexcept = default;
 
 DefaultObjectImpl::
 DefaultObjectImpl(
-    storage_type entries) noexcept
+    storage_type entries)
     : entries_(std::move(entries))
 {
+    if(entries_.size() > index_threshold)
+        reindex();
 }
 
 std::size_t
@@ -151,35 +168,33 @@ DefaultObjectImpl::
 get(std::string_view key) const ->
     Value
 {
-    auto it = std::ranges::find_if(
-        entries_.begin(), entries_.end(),
-        [key](auto const& kv)
-    {
-        return kv.key == key;
-    });
-    if (it == entries_.end())
+    std::size_t const i = find(key);
+    if (i == entries_.size())
     {
         return Kind::Undefined;
     }
-    return it->value;
+    return entries_[i].value;
 }
 
 void
 DefaultObjectImpl::
 set(String key, Value value)
 {
-
-    auto it = std::ranges::find_if(
-        entries_.begin(), entries_.end(),
-        [key](auto const& kv)
-        {
-            return kv.key == key;
-        });
-    if(it == entries_.end())
-        entries_.emplace_back(
-            key, std::move(value));
+    std::size_t const i = find(key);
+    if(i != entries_.size())
+    {
+        entries_[i].value = std::move(value);
+        return;
+    }
+    entries_.emplace_back(
+        std::move(key), std::move(value));
+    if(entries_.size() <= index_threshold)
+        return;
+    // Keep the table at most half full
+    if(entries_.size() * 2 > index_.size())
+        reindex();
     else
-        it->value = std::move(value);
+        insertIndex(entries_.size() - 1);
 }
 
 bool
@@ -198,13 +213,61 @@ visit(std::function<bool(String, Value)> visitor) const
 
 bool
 DefaultObjectImpl::exists(std::string_view key) const {
-    auto it = std::ranges::find_if(
-        entries_.begin(), entries_.end(),
-        [key](auto const& kv)
+    return find(key) != entries_.size();
+}
+
+std::size_t
+DefaultObjectImpl::
+find(std::string_view key) const noexcept
+{
+    if(index_.empty())
+    {
+        auto it = std::ranges::find_if(
+            entries_.begin(), entries_.end(),
+            [key](auto const& kv)
+            {
+                return kv.key == key;
+            });
+        return it - entries_.begin();
+    }
+    std::size_t const mask = index_.size() - 1;
+    for(std::size_t i = hashKey(key) & mask;; i = (i + 1) & mask)
+    {
+        std::uint32_t const pos = index_[i];
+        if(pos == empty_slot)
+            return entries_.size();
+        if(entries_[pos].key == key)
+            return pos;
+    }
+}
+
+void
+DefaultObjectImpl::
+insertIndex(std::size_t pos)
+{
+    std::string_view key = entries_[pos].key;
+    std::size_t const mask = index_.size() - 1;
+    for(std::size_t i = hashKey(key) & mask;; i = (i + 1) & mask)
+    {
+        if(index_[i] == empty_slot)
         {
-            return kv.key == key;
-        });
-    return it != entries_.end();
+            index_[i] = static_cast<std::uint32_t>(pos);
+            return;
+        }
+        // When a key is repeated, the first
+        // entry is found, as in a linear search
+        if(entries_[index_[i]].key == key)
+            return;
+    }
+}
+
+void
+DefaultObjectImpl::
+reindex()
+{
+    index_.assign(std::bit_ceil(entries_.size() * 4), empty_slot);
+    for(std::size_t i = 0; i < entries_.size(); ++i)
+        insertIndex(i);
 }
 
 //------------------------------------------------
@@ -13,7 +13,9 @@
 #include "lib/Support/Radix.hpp"
 #include <mrdocs/Support/RangeFor.hpp>
 #include <mrdocs/Support/String.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 #include <fmt/format.h>
+#include <algorithm>
 #include <iterator>
 
 #include <llvm/Support/raw_ostream.h>
@@ -545,18 +547,100 @@ construct(Info const& I) const
     return dom::newObject<AdocInfo>(I, *this);
 }
 
-std::string
+AdocCorpus::
+AdocCorpus(
+    Corpus const& corpus,
+    Options&& opts)
+    : DomCorpus(corpus)
+    , options(std::move(opts))
+    , names_(corpus, options.legible_names)
+{
+}
+
+Error
+AdocCorpus::
+init()
+{
+    constexpr std::size_t chunkSize = 1024;
+    Corpus const& corpus = getCorpus();
+    auto const infos = corpus.infos();
+    refs_.resize(infos.size());
+    TaskGroup taskGroup(corpus.config.threadPool());
+    for(std::size_t first = 0; first < infos.size(); first += chunkSize)
+    {
+        taskGroup.async([this, infos, first]
+        {
+            std::size_t const last =
+                std::min(first + chunkSize, infos.size());
+            for(std::size_t i = first; i < last; ++i)
+            {
+                // symbols which are not reachable from the
+                // global namespace have no legible name
+                if(names_.contains(infos[i]->id))
+                    refs_[i] = makeRefs(*infos[i]);
+            }
+        });
+    }
+    auto errors = taskGroup.wait();
+    if(! errors.empty())
+    {
+        refs_.clear();
+        return Error(errors);
+    }
+    return Error::success();
+}
+
+auto
+AdocCorpus::
+makeRefs(Info const& I) const ->
+    Refs
+{
+    Refs refs;
+    refs.sectionRef = names_.getQualified(I.id, '-');
+    if(! getCorpus().config->multipage)
+    {
+        // single-page references are section references
+        refs.xref = refs.sectionRef;
+        return refs;
+    }
+    // use '/' as the seperator for multipage,
+    // and add the file extension
+    std::string xref = names_.getQualified(I.id, '/');
+    xref.append(".adoc");
+    refs.xref = xref;
+    return refs;
+}
+
+auto
+AdocCorpus::
+getRefs(Info const& I) const ->
+    Refs
+{
+    // the symbol table gives the position
+    // of the symbol without a search
+    Corpus const& corpus = getCorpus();
+    std::size_t const index = corpus.indexOf(I.id);
+    if(index < refs_.size() && corpus.infos()[index] == &I)
+    {
+        Refs const& refs = refs_[index];
+        if(! refs.xref.empty())
+            return refs;
+    }
+    return makeRefs(I);
+}
+
+dom::String
 AdocCorpus::
 getXref(Info const& I) const
 {
-    bool multipage = getCorpus().config->multipage;
-    // use '/' as the seperator for multipage, and '-' for single-page
-    std::string xref = names_.getQualified(
-        I.id, multipage ? '/' : '-');
-    // add the file extension if in multipage mode
-    if(multipage)
-        xref.append(".adoc");
-    return xref;
+    return getRefs(I).xref;
+}
+
+dom::String
+AdocCorpus::
+getSectionRef(Info const& I) const
+{
+    return getRefs(I).sectionRef;
 }
 
 std::string
@@ -16,6 +16,7 @@
 #include "Options.hpp"
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <optional>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -23,28 +24,58 @@ namespace adoc {
 
 class AdocCorpus : public DomCorpus
 {
+    // The references of a symbol, computed
+    // once for every symbol in the corpus.
+    struct Refs
+    {
+        dom::String xref;
+        dom::String sectionRef;
+    };
+
+    // aligned with Corpus::infos, and
+    // found with Corpus::indexOf
+    std::vector<Refs> refs_;
+
+    Refs
+    makeRefs(Info const& I) const;
+
+    Refs
+    getRefs(Info const& I) const;
+
 public:
     Options options;
     LegibleNames names_;
 
     AdocCorpus(
         Corpus const& corpus,
-        Options&& opts)
-        : DomCorpus(corpus)
-        , options(std::move(opts))
-        , names_(corpus, options.legible_names)
-    {
-    }
+        Options&& opts);
+
+    /** Build the references of all symbols.
+
+        The cross-references and section references
+        of all symbols are built in parallel, so the
+        pages of the symbols share them instead of
+        composing them from the legible names of
+        their parents. This must be called before
+        the pages are rendered.
+    */
+    Error
+    init();
 
     dom::Object
     construct(Info const& I) const override;
 
-    std::string
+    dom::String
     getXref(Info const& I) const;
 
     std::string
     getXref(OverloadSet const& os) const;
 
+    /** Return the section reference of a symbol.
+    */
+    dom::String
+    getSectionRef(Info const& I) const;
+
     dom::Value
     getJavadoc(
         Javadoc const& jd) const override;
@@ -29,50 +29,17 @@ namespace adoc {
 
 Builder::
 Builder(
-    AdocCorpus const& corpus)
-    : domCorpus(corpus)
+    AdocCorpus const& corpus,
+    std::shared_ptr<AddonBundle const> addons)
+    : addons_(std::move(addons))
+    , domCorpus(corpus)
 {
-    namespace fs = std::filesystem;
-
     Config const& config = domCorpus->config;
 
-    // load partials
-    std::string partialsPath = files::appendPath(
-        config->addons, "generator", "asciidoc", "partials");
-    forEachFile(partialsPath, true,
-        [&](std::string_view pathName) -> Error
-        {
-            fs::path path = pathName;
-            if(path.extension() != ".hbs")
-                return Error::success();
-            path = path.lexically_relative(partialsPath);
-            while(path.has_extension())
-                path.replace_extension();
-
-            auto text = files::getFileText(pathName);
-            if (! text)
-                return text.error();
-
-            hbs_.registerPartial(
-                path.generic_string(), *text);
-            return Error::success();
-    }).maybeThrow();
-
-    // Load JavaScript helpers
-    std::string helpersPath = files::appendPath(
-        config->addons, "generator", "asciidoc", "helpers");
-    forEachFile(helpersPath, true,
-        [&](std::string_view pathName)-> Expected<void>
-        {
-            // Register JS helper function in the global object
-            constexpr std::string_view ext = ".js";
-            if (!pathName.ends_with(ext)) return {};
-            auto name = files::getFileName(pathName);
-            name.remove_suffix(ext.size());
-            MRDOCS_TRY(auto script, files::getFileText(pathName));
-            MRDOCS_TRY(js::registerHelper(hbs_, name, ctx_, script));
-            return {};
-        }).maybeThrow();
+    // Register the partials and helpers
+    // shared by all the builders
+    if (auto exp = addons_->install(hbs_, ctx_); !exp)
+        exp.error().Throw();
 
     hbs_.registerHelper(
         "is_multipage",
@@ -131,16 +98,11 @@ callTemplate(
     std::string_view name,
     dom::Value const& context)
 {
-    Config const& config = domCorpus->config;
-
-    auto layoutDir = files::appendPath(config->addons,
-            "generator", "asciidoc", "layouts");
-    auto pathName = files::appendPath(layoutDir, name);
-    MRDOCS_TRY(auto fileText, files::getFileText(pathName));
+    MRDOCS_TRY(auto layout, addons_->layouts().get(name));
     HandlebarsOptions options;
     options.noEscape = true;
     Expected<std::string, HandlebarsError> exp =
-        hbs_.try_render(fileText, context, options);
+        hbs_.try_render(layout, context, options);
     if (!exp)
     {
         return Unexpected(Error(exp.error().what()));
@@ -192,7 +154,7 @@ createContext(
         getRelPrefix(I.Namespace.size()));
     props.emplace_back("config", domCorpus->config.object());
     props.emplace_back("sectionref",
-        domCorpus.names_.getQualified(I.id, '-'));
+        domCorpus.getSectionRef(I));
     return dom::Object(std::move(props));
 }
 
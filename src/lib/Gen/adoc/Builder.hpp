@@ -14,10 +14,12 @@
 #include "Options.hpp"
 #include "AdocCorpus.hpp"
 #include "lib/Support/Radix.hpp"
+#include "lib/Support/AddonBundle.hpp"
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/JavaScript.hpp>
 #include <mrdocs/Support/Handlebars.hpp>
+#include <memory>
 #include <ostream>
 
 #include <mrdocs/Dom.hpp>
@@ -35,15 +37,16 @@ class Builder
 {
     js::Context ctx_;
     Handlebars hbs_;
+    std::shared_ptr<AddonBundle const> addons_;
 
     std::string getRelPrefix(std::size_t depth);
 
 public:
     AdocCorpus const& domCorpus;
 
-    explicit
     Builder(
-        AdocCorpus const& corpus);
+        AdocCorpus const& corpus,
+        std::shared_ptr<AddonBundle const> addons);
 
     dom::Value createContext(Info const& I);
     dom::Value createContext(OverloadSet const& OS);
@@ -29,52 +29,19 @@ namespace html {
 Builder::
 Builder(
     DomCorpus const& domCorpus,
-    Options const& options)
+    Options const& options,
+    std::shared_ptr<AddonBundle const> addons)
     : domCorpus_(domCorpus)
     , corpus_(domCorpus_.getCorpus())
     , options_(options)
+    , addons_(std::move(addons))
 {
-    namespace fs = std::filesystem;
-
     Config const& config = corpus_.config;
 
-    // load partials
-    std::string partialsPath = files::appendPath(
-        config->addons, "generator", "html", "partials");
-    forEachFile(partialsPath, true,
-        [&](std::string_view pathName) -> Error
-        {
-            fs::path path = pathName;
-            if(path.extension() != ".hbs")
-                return Error::success();
-            path = path.lexically_relative(partialsPath);
-            while(path.has_extension())
-                path.replace_extension();
-
-            auto text = files::getFileText(pathName);
-            if (! text)
-                return text.error();
-
-            hbs_.registerPartial(
-                path.generic_string(), *text);
-            return Error::success();
-    }).maybeThrow();
-
-    // Load JavaScript helpers
-    std::string helpersPath = files::appendPath(
-        config->addons, "generator", "html", "helpers");
-    forEachFile(helpersPath, true,
-        [&](std::string_view pathName)-> Expected<void>
-        {
-            // Register JS helper function in the global object
-            constexpr std::string_view ext = ".js";
-            if (!pathName.ends_with(ext)) return {};
-            auto name = files::getFileName(pathName);
-            name.remove_suffix(ext.size());
-            MRDOCS_TRY(auto script, files::getFileText(pathName));
-            MRDOCS_TRY(js::registerHelper(hbs_, name, ctx_, script));
-            return {};
-        }).maybeThrow();
+    // Register the partials and helpers
+    // shared by all the builders
+    if (auto exp = addons_->install(hbs_, ctx_); !exp)
+        exp.error().Throw();
 
     hbs_.registerHelper(
         "is_multipage",
@@ -132,20 +99,15 @@ callTemplate(
     std::string_view name,
     dom::Value const& context)
 {
-    Config const& config = corpus_.config;
-
     js::Scope scope(ctx_);
 
 
     auto Handlebars = scope.getGlobal("Handlebars");
-    auto layoutDir = files::appendPath(config->addons,
-            "generator", "html", "layouts");
-    auto pathName = files::appendPath(layoutDir, name);
-    MRDOCS_TRY(auto fileText, files::getFileText(pathName));
+    MRDOCS_TRY(auto layout, addons_->layouts().get(name));
     HandlebarsOptions options;
     options.noEscape = true;
     Expected<std::string, HandlebarsError> exp =
-        hbs_.try_render(fileText, context, options);
+        hbs_.try_render(layout, context, options);
     if (!exp)
     {
         return Unexpected(Error(exp.error().what()));
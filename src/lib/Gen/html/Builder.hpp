@@ -13,10 +13,12 @@
 
 #include "Options.hpp"
 #include "lib/Support/Radix.hpp"
+#include "lib/Support/AddonBundle.hpp"
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/Handlebars.hpp>
 #include <mrdocs/Support/JavaScript.hpp>
+#include <memory>
 #include <ostream>
 
 namespace clang {
@@ -35,13 +37,15 @@ class Builder
     Options options_;
     js::Context ctx_;
     Handlebars hbs_;
+    std::shared_ptr<AddonBundle const> addons_;
 
     std::string getRelPrefix(std::size_t depth);
 
 public:
     Builder(
         DomCorpus const& domCorpus,
-        Options const& options);
+        Options const& options,
+        std::shared_ptr<AddonBundle const> addons);
 
     dom::Value createContext(SymbolID const& id);
     dom::Value createContext(OverloadSet const& OS);
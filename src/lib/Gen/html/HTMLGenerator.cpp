@@ -14,10 +14,13 @@
 #include "Builder.hpp"
 #include "MultiPageVisitor.hpp"
 #include "SinglePageVisitor.hpp"
+#include "lib/Support/Chrono.hpp"
 #include "lib/Support/LegibleNames.hpp"
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/Path.hpp>
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -33,17 +36,37 @@ createExecutors(
     auto const& config = domCorpus->config;
     auto& threadPool = config.threadPool();
     ExecutorGroup<Builder> group(threadPool);
+    using clock_type = std::chrono::steady_clock;
+    auto start_time = clock_type::now();
+    std::shared_ptr<AddonBundle const> addons;
+    try
+    {
+        // The addons are loaded once and
+        // shared by all the builders
+        addons = std::make_shared<AddonBundle const>(
+            config->addons, "html");
+    }
+    catch(Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
     for(auto i = threadPool.getThreadCount(); i--;)
     {
         try
         {
-           group.emplace(domCorpus, options);
+           group.emplace(domCorpus, options, addons);
         }
         catch(Exception const& ex)
         {
             return Unexpected(ex.error());
         }
     }
+    report::info(
+        "Loaded {} partials and {} helpers for {} agents in {}",
+        addons->partialCount(),
+        addons->helperCount(),
+        threadPool.getThreadCount(),
+        format_duration(clock_type::now() - start_time));
     return group;
 }
 
@@ -17,8 +17,13 @@
 #include "lib/Support/Radix.hpp"
 #include "lib/Support/LegibleNames.hpp"
 #include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <mrdocs/Support/unlock_guard.hpp>
 #include <llvm/Support/YAMLParser.h>
 #include <llvm/Support/YAMLTraits.h>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 //------------------------------------------------
 //
@@ -101,6 +106,115 @@ namespace clang {
 namespace mrdocs {
 namespace xml {
 
+//------------------------------------------------
+//
+// Chunks
+//
+//------------------------------------------------
+
+/** Output which is rendered concurrently and written in order.
+
+    The writer for the outline of the document
+    renders into a buffer, which becomes a chunk
+    each time a subtree is submitted to the thread
+    pool. A chunk is written to the output as soon
+    as all of the chunks before it are written.
+*/
+class XMLWriter::Chunks
+{
+    llvm::raw_ostream& out_;
+    TaskGroup taskGroup_;
+    std::mutex mutex_;
+    std::size_t numChunks_ = 0;
+    std::size_t topChunk_ = 0;
+    std::vector<std::optional<
+        std::string>> chunks_;
+
+public:
+    std::string text;
+    llvm::raw_string_ostream os{text};
+
+    Chunks(
+        llvm::raw_ostream& out,
+        ThreadPool& threadPool)
+        : out_(out)
+        , taskGroup_(threadPool)
+    {
+    }
+
+    /** Return the number of the next chunk.
+
+        Only the writer of the outline reserves
+        chunks, so no synchronization is needed.
+    */
+    std::size_t
+    reserve() noexcept
+    {
+        return numChunks_++;
+    }
+
+    /** Submit the outline rendered so far as a chunk.
+    */
+    void
+    flush()
+    {
+        if(text.empty())
+            return;
+        write(std::move(text), reserve());
+        text.clear();
+    }
+
+    template<class F>
+    void
+    async(F&& f)
+    {
+        taskGroup_.async(std::forward<F>(f));
+    }
+
+    // chunkNumber is zero-based
+    void
+    write(
+        std::string chunkText,
+        std::size_t chunkNumber)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if(chunkNumber > topChunk_)
+        {
+            // defer this chunk
+            if(chunks_.size() <= chunkNumber)
+                chunks_.resize(chunkNumber + 1);
+            chunks_[chunkNumber] = std::move(chunkText);
+            return;
+        }
+
+        // write contiguous chunks
+        for(;;)
+        {
+            {
+                unlock_guard unlock(mutex_);
+                out_.write(chunkText.data(), chunkText.size());
+                ++chunkNumber;
+            }
+            topChunk_ = chunkNumber;
+            if(chunkNumber >= chunks_.size())
+                return;
+            if(! chunks_[chunkNumber])
+                return;
+            chunkText = std::move(*chunks_[chunkNumber]);
+            chunks_[chunkNumber].reset();
+        }
+    }
+
+    [[nodiscard]]
+    std::vector<Error>
+    wait()
+    {
+        flush();
+        return taskGroup_.wait();
+    }
+};
+
 //------------------------------------------------
 //
 // XMLWriter
@@ -139,10 +253,33 @@ build()
             "<mrdocs xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
             "       xsi:noNamespaceSchemaLocation=\"https://github.com/cppalliance/mrdocs/raw/develop/mrdocs.rnc\">\n";
 
-    if(options_.index || options_.legible_names)
-        writeIndex();
+    ThreadPool& threadPool = corpus_.config.threadPool();
+    if(threadPool.getThreadCount() <= 1)
+    {
+        if(options_.index || options_.legible_names)
+            writeIndex();
 
-    visit(corpus_.globalNamespace(), *this);
+        visit(corpus_.globalNamespace(), *this);
+    }
+    else
+    {
+        // the outline is written on this thread, and the
+        // subtrees are rendered on the thread pool. the
+        // output is identical to that of the serial writer
+        Chunks chunks(os_, threadPool);
+        XMLWriter outline(chunks.os, corpus_);
+        outline.options_ = options_;
+        outline.chunks_ = &chunks;
+
+        if(options_.index || options_.legible_names)
+            outline.writeIndex();
+
+        visit(corpus_.globalNamespace(), outline);
+
+        auto errors = chunks.wait();
+        if(! errors.empty())
+            return Error(errors);
+    }
 
     if(options_.prolog)
         os_ << "</mrdocs>\n";
@@ -156,31 +293,123 @@ void
 XMLWriter::
 writeIndex()
 {
-    std::string temp;
-    temp.reserve(256);
+    if(options_.legible_names)
+        legibleNames_ = std::make_shared<LegibleNames>(corpus_, true);
     tags_.open("symbols");
+    std::span<Info const* const> infos = corpus_.infos();
+    if(! chunks_)
+    {
+        writeSymbols(infos);
+    }
+    else
+    {
+        constexpr std::size_t chunkSize = 1024;
+        while(! infos.empty())
+        {
+            auto chunk = infos.first(std::min(chunkSize, infos.size()));
+            infos = infos.subspan(chunk.size());
+            async([chunk](XMLWriter& writer)
+            {
+                writer.writeSymbols(chunk);
+            });
+        }
+    }
+    tags_.close("symbols");
+}
+
+void
+XMLWriter::
+writeSymbols(
+    std::span<Info const* const> infos)
+{
     if(options_.legible_names)
     {
-        LegibleNames names(corpus_, true);
-        for(auto& I : corpus_)
+        for(Info const* I : infos)
         {
-            auto legible_name = names.getUnqualified(I.id);
+            auto legible_name = legibleNames_->getUnqualified(I->id);
             tags_.write("symbol", {}, {
                 { "legible", legible_name },
-                { "name", corpus_.getFullyQualifiedName(I, temp) },
-                { "tag", toString(I.Kind) },
-                { I.id } });
+                { "name", corpus_.qualifiedName(*I) },
+                { "tag", toString(I->Kind) },
+                { I->id } });
         }
     }
     else
     {
-        for(auto& I : corpus_)
+        for(Info const* I : infos)
             tags_.write("symbol", {}, {
-                { "name", corpus_.getFullyQualifiedName(I, temp) },
-                { "tag", toString(I.Kind) },
-                { I.id } });
+                { "name", corpus_.qualifiedName(*I) },
+                { "tag", toString(I->Kind) },
+                { I->id } });
     }
-    tags_.close("symbols");
+}
+
+/** Render part of the document on the thread pool.
+
+    The function object is invoked with a writer
+    which continues at the current indentation, and
+    its output is placed after everything written
+    so far by this writer.
+*/
+template<class F>
+void
+XMLWriter::
+async(F f)
+{
+    MRDOCS_ASSERT(chunks_);
+    chunks_->flush();
+    chunks_->async(
+    [this, f = std::move(f),
+        chunk = chunks_->reserve(),
+        indent = tags_.indent_]
+    {
+        std::string text;
+        llvm::raw_string_ostream os(text);
+        XMLWriter writer(os, corpus_);
+        writer.options_ = options_;
+        writer.legibleNames_ = legibleNames_;
+        writer.tags_.indent_ = indent;
+        f(writer);
+        chunks_->write(std::move(text), chunk);
+    });
+}
+
+void
+XMLWriter::
+writeMembers(
+    NamespaceInfo const& I)
+{
+    // namespaces are written in order on this thread,
+    // and each run of other members is rendered on
+    // the thread pool, in batches to limit the
+    // number of chunks
+    constexpr std::size_t batchSize = 64;
+    std::vector<Info const*> batch;
+    auto submit = [&]
+    {
+        if(batch.empty())
+            return;
+        async([batch = std::move(batch)](XMLWriter& writer)
+        {
+            for(Info const* M : batch)
+                visit(*M, writer);
+        });
+        batch.clear();
+    };
+    for(SymbolID const& id : I.Members)
+    {
+        Info const& M = corpus_.get(id);
+        if(M.isNamespace())
+        {
+            submit();
+            visit(M, *this);
+            continue;
+        }
+        batch.push_back(&M);
+        if(batch.size() == batchSize)
+            submit();
+    }
+    submit();
 }
 
 //------------------------------------------------
@@ -211,7 +440,10 @@ writeNamespace(
     writeJavadoc(I.javadoc);
     for(const SymbolID& id : I.UsingDirectives)
         tags_.write("using-directive", {}, { { id } });
-    corpus_.traverse(I, *this);
+    if(chunks_)
+        writeMembers(I);
+    else
+        corpus_.traverse(I, *this);
     tags_.close(namespaceTagName);
 }
 
@@ -626,7 +858,7 @@ writeLocation(
     bool def)
 {
     tags_.write("file", {}, {
-        { "path", loc.Filename },
+        { "path", loc.filename() },
         { "line", std::to_string(loc.LineNumber) },
         { "class", "def", def } });
 }
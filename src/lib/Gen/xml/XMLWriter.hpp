@@ -17,10 +17,15 @@
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Support/Error.hpp>
+#include <memory>
+#include <span>
 #include <string>
 
 namespace clang {
 namespace mrdocs {
+
+class LegibleNames;
+
 namespace xml {
 
 class jit_indenter;
@@ -47,6 +52,18 @@ protected:
     };
     Options options_;
 
+    class Chunks;
+
+    // set when rendering on the thread pool
+    Chunks* chunks_ = nullptr;
+    std::shared_ptr<LegibleNames const> legibleNames_;
+
+    template<class F>
+    void async(F f);
+
+    void writeMembers(NamespaceInfo const& I);
+    void writeSymbols(std::span<Info const* const> infos);
+
 public:
     XMLWriter(
         llvm::raw_ostream& os,
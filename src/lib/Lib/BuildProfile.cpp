@@ -0,0 +1,169 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "BuildProfile.hpp"
+#include "lib/Support/Chrono.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <ranges>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+double
+toMilliseconds(BuildProfile::duration d) noexcept
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+std::string
+formatBytes(std::size_t n)
+{
+    return fmt::format("{:.1f} MB", double(n) / (1024 * 1024));
+}
+
+} // (anon)
+
+void
+BuildProfile::
+add(
+    TranslationUnit unit,
+    std::span<std::pair<std::string, duration> const> files)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    units_.push_back(std::move(unit));
+    for (auto const& [path, time] : files)
+    {
+        File& file = files_[path];
+        file.time += time;
+        ++file.translationUnits;
+    }
+}
+
+std::vector<BuildProfile::TranslationUnit>
+BuildProfile::
+translationUnits() const
+{
+    std::vector<TranslationUnit> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result = units_;
+    }
+    std::ranges::sort(result, std::ranges::greater{},
+        &TranslationUnit::time);
+    return result;
+}
+
+std::vector<BuildProfile::File>
+BuildProfile::
+files() const
+{
+    std::vector<File> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(files_.size());
+        for (auto const& [path, file] : files_)
+        {
+            result.push_back(file);
+            result.back().file = path;
+        }
+    }
+    std::ranges::sort(result, std::ranges::greater{}, &File::time);
+    return result;
+}
+
+void
+BuildProfile::
+print(
+    report::Level level,
+    std::size_t n) const
+{
+    auto const units = translationUnits();
+    std::string s = fmt::format(
+        "Slowest translation units:\n{:>10}  {:>10}  {}\n",
+        "time", "memory", "file");
+    for (auto const& unit : units | std::views::take(n))
+    {
+        s += fmt::format("{:>10}  {:>10}  {}\n",
+            format_duration(unit.time),
+            formatBytes(unit.memory),
+            unit.file);
+    }
+
+    auto const files = this->files();
+    s += fmt::format(
+        "Slowest files to extract:\n{:>10}  {:>10}  {}\n",
+        "time", "units", "file");
+    for (auto const& file : files | std::views::take(n))
+    {
+        s += fmt::format("{:>10}  {:>10}  {}\n",
+            format_duration(file.time),
+            file.translationUnits,
+            file.file);
+    }
+    s.pop_back();
+    report::log(level, "{}", s);
+}
+
+Expected<void>
+BuildProfile::
+write(std::string_view path) const
+{
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+    if (ec)
+    {
+        return Unexpected(formatError(
+            "Failed to open \"{}\": {}", path, ec));
+    }
+
+    llvm::json::OStream J(os, 2);
+    J.object([&]
+    {
+        J.attributeArray("translationUnits", [&]
+        {
+            for (auto const& unit : translationUnits())
+            {
+                J.object([&]
+                {
+                    J.attribute("file", unit.file);
+                    J.attribute("ms", toMilliseconds(unit.time));
+                    J.attribute("memory", static_cast<std::int64_t>(unit.memory));
+                });
+            }
+        });
+        J.attributeArray("files", [&]
+        {
+            for (auto const& file : files())
+            {
+                J.object([&]
+                {
+                    J.attribute("file", file.file);
+                    J.attribute("ms", toMilliseconds(file.time));
+                    J.attribute("translationUnits",
+                        static_cast<std::int64_t>(file.translationUnits));
+                });
+            }
+        });
+    });
+    os << '\n';
+    os.close();
+    if (os.has_error())
+    {
+        os.clear_error();
+        return Unexpected(formatError("Failed to write \"{}\"", path));
+    }
+    return {};
+}
+
+} // mrdocs
+} // clang
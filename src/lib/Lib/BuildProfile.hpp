@@ -0,0 +1,123 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_BUILDPROFILE_HPP
+#define MRDOCS_LIB_LIB_BUILDPROFILE_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The cost of the translation units and headers of a build.
+
+    Each translation unit records the time spent
+    parsing and visiting it, and the memory clang
+    allocated for it. The time spent visiting
+    declarations is attributed to the file where
+    each declaration is written, so the headers
+    which are expensive to extract can be found.
+
+    The profile can be used concurrently.
+*/
+class BuildProfile
+{
+public:
+    using duration = std::chrono::steady_clock::duration;
+
+    /** The cost of a translation unit.
+    */
+    struct TranslationUnit
+    {
+        /** The path of the main file.
+        */
+        std::string file;
+
+        /** The time spent parsing and visiting.
+        */
+        duration time{};
+
+        /** The bytes clang allocated for the translation unit.
+        */
+        std::size_t memory = 0;
+    };
+
+    /** The cost of a file.
+    */
+    struct File
+    {
+        /** The path of the file.
+        */
+        std::string file;
+
+        /** The time spent visiting its declarations.
+        */
+        duration time{};
+
+        /** The number of translation units which visited it.
+        */
+        std::size_t translationUnits = 0;
+    };
+
+    /** Add the cost of a translation unit.
+
+        @param unit The cost of the translation unit.
+        @param files The time spent visiting the
+        declarations of each file.
+    */
+    void
+    add(
+        TranslationUnit unit,
+        std::span<std::pair<std::string, duration> const> files);
+
+    /** Return the translation units, most expensive first.
+    */
+    std::vector<TranslationUnit>
+    translationUnits() const;
+
+    /** Return the files, most expensive first.
+    */
+    std::vector<File>
+    files() const;
+
+    /** Print the most expensive translation units and files.
+
+        @param level The report level.
+        @param n The number of entries in each table.
+    */
+    void
+    print(
+        report::Level level,
+        std::size_t n) const;
+
+    /** Write the profile to a file as JSON.
+
+        @param path The path of the file.
+    */
+    Expected<void>
+    write(std::string_view path) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<TranslationUnit> units_;
+    std::unordered_map<std::string, File> files_;
+};
+
+} // mrdocs
+} // clang
+
+#endif
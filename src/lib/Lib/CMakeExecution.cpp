@@ -11,10 +11,14 @@
 #include "lib/Lib/CMakeExecution.hpp"
 #include "lib/Support/Path.hpp"
 
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
 
 namespace clang {
 namespace mrdocs {
@@ -195,13 +199,158 @@ getCmakeDefaultGenerator(llvm::StringRef cmakePath)
     return "Unix Makefiles";
 }
 
+/* Writes a file in the cache directory.
+
+   The contents are written to a temporary file
+   first, so readers never see a partial file.
+   A failure to write the cache is not an error.
+ */
+void
+writeCacheFile(std::string const& path, llvm::StringRef contents)
+{
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if (llvm::sys::fs::create_directories(files::getParentDir(path)) ||
+        llvm::sys::fs::createUniqueFile(path + ".%%%%%%%%.tmp", fd, tempPath))
+    {
+        return;
+    }
+    bool failed;
+    {
+        llvm::raw_fd_ostream os(fd, true);
+        os << contents;
+        os.close();
+        failed = os.has_error();
+        os.clear_error();
+    }
+    if (failed || llvm::sys::fs::rename(tempPath, path))
+    {
+        llvm::sys::fs::remove(tempPath);
+    }
+}
+
+/* Returns the default generator of CMake.
+
+   When a cache directory is given, the generator
+   is stored there, keyed by the path, size and
+   modification time of the CMake executable.
+ */
+Expected<std::string>
+getCmakeDefaultGenerator(llvm::StringRef cmakePath, llvm::StringRef cacheDir)
+{
+    std::string cacheFile;
+    llvm::sys::fs::file_status status;
+    if (!cacheDir.empty() && !llvm::sys::fs::status(cmakePath, status))
+    {
+        llvm::SHA1 hasher;
+        hasher.update(cmakePath);
+        hasher.update(std::to_string(status.getSize()));
+        hasher.update(std::to_string(status.getLastModificationTime()
+            .time_since_epoch().count()));
+        cacheFile = files::appendPath(cacheDir, "cmake",
+            "generator-" + llvm::toHex(hasher.final(), true) + ".txt");
+        if (auto buffer = llvm::MemoryBuffer::getFile(cacheFile))
+        {
+            return buffer.get()->getBuffer().str();
+        }
+    }
+    MRDOCS_TRY(std::string generator, getCmakeDefaultGenerator(cmakePath));
+    if (!cacheFile.empty())
+    {
+        writeCacheFile(cacheFile, generator);
+    }
+    return generator;
+}
+
 Expected<bool>
-cmakeDefaultGeneratorIsVisualStudio(llvm::StringRef cmakePath)
+cmakeDefaultGeneratorIsVisualStudio(llvm::StringRef cmakePath, llvm::StringRef cacheDir)
 {
-    MRDOCS_TRY(auto const defaultGenerator, getCmakeDefaultGenerator(cmakePath));
+    MRDOCS_TRY(auto const defaultGenerator, getCmakeDefaultGenerator(cmakePath, cacheDir));
     return defaultGenerator.starts_with("Visual Studio");
 }
 
+/* Returns a hash of the inputs of the CMake configuration.
+
+   The hash covers the CMake executable, the CMake
+   arguments, the contents of every CMake script,
+   preset and configure_file template, and the paths
+   of the source files, since CMake scripts often glob
+   for them. Hidden directories, build directories,
+   and the cache directory are skipped.
+ */
+std::string
+hashCmakeProject(
+    llvm::StringRef projectPath,
+    llvm::StringRef cmakePath,
+    llvm::StringRef cmakeArgs,
+    llvm::StringRef cacheDir)
+{
+    namespace fs = llvm::sys::fs;
+    namespace path = llvm::sys::path;
+
+    auto isCmakeFile = [](llvm::StringRef name)
+    {
+        return name == "CMakeLists.txt" ||
+            name == "CMakePresets.json" ||
+            name == "CMakeUserPresets.json" ||
+            name.ends_with(".cmake") ||
+            name.ends_with(".in");
+    };
+    auto isSourceFile = [](llvm::StringRef name)
+    {
+        llvm::StringRef const ext = path::extension(name);
+        return ext == ".c" || ext == ".cc" || ext == ".cpp" ||
+            ext == ".cxx" || ext == ".c++" || ext == ".h" ||
+            ext == ".hh" || ext == ".hpp" || ext == ".hxx" ||
+            ext == ".ipp" || ext == ".inl";
+    };
+
+    std::string const normalizedCacheDir = files::normalizePath(cacheDir);
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(projectPath, ec), end;
+         it != end && !ec; it.increment(ec))
+    {
+        std::string const& filePath = it->path();
+        llvm::StringRef const name = path::filename(filePath);
+        if (it->type() == fs::file_type::directory_file)
+        {
+            if (name.starts_with(".") ||
+                (!cacheDir.empty() && files::normalizePath(filePath) == normalizedCacheDir) ||
+                files::exists(files::appendPath(filePath, "CMakeCache.txt")))
+            {
+                it.no_push();
+            }
+            continue;
+        }
+        if (isCmakeFile(name) || isSourceFile(name))
+        {
+            paths.push_back(filePath);
+        }
+    }
+    std::ranges::sort(paths);
+
+    llvm::SHA1 hasher;
+    hasher.update(cmakePath);
+    hasher.update(llvm::ArrayRef<std::uint8_t>{0});
+    hasher.update(cmakeArgs);
+    hasher.update(llvm::ArrayRef<std::uint8_t>{0});
+    for (std::string const& filePath : paths)
+    {
+        hasher.update(filePath);
+        hasher.update(llvm::ArrayRef<std::uint8_t>{0});
+        if (isCmakeFile(path::filename(filePath)))
+        {
+            if (auto buffer = llvm::MemoryBuffer::getFile(filePath))
+            {
+                hasher.update(buffer.get()->getBuffer());
+            }
+            hasher.update(llvm::ArrayRef<std::uint8_t>{0});
+        }
+    }
+    return llvm::toHex(hasher.final(), true);
+}
+
 Expected<std::string_view>
 parseBashIdentifier(std::string_view str)
 {
@@ -390,7 +539,8 @@ Expected<void>
 pushCMakeArgs(
     std::string const& cmakePath,
     std::vector<llvm::StringRef> &args,
-    std::vector<std::string> const& additionalArgs) {
+    std::vector<std::string> const& additionalArgs,
+    llvm::StringRef cacheDir) {
     bool visualStudioFound = false;
     for (size_t i = 0; i < additionalArgs.size(); ++i)
     {
@@ -447,7 +597,7 @@ pushCMakeArgs(
     {
         MRDOCS_TRY(
             bool const cmakeDefaultGeneratorIsVisualStudio,
-            cmakeDefaultGeneratorIsVisualStudio(cmakePath));
+            cmakeDefaultGeneratorIsVisualStudio(cmakePath, cacheDir));
         if (cmakeDefaultGeneratorIsVisualStudio)
         {
             args.emplace_back("-GNinja");
@@ -459,16 +609,55 @@ pushCMakeArgs(
 } // anonymous namespace
 
 Expected<std::string>
-executeCmakeExportCompileCommands(llvm::StringRef projectPath, llvm::StringRef cmakeArgs, llvm::StringRef buildDir)
+executeCmakeExportCompileCommands(
+    llvm::StringRef projectPath,
+    llvm::StringRef cmakeArgs,
+    llvm::StringRef buildDir,
+    llvm::StringRef cacheDir)
 {
     MRDOCS_CHECK(llvm::sys::fs::exists(projectPath), "Project path does not exist");
+
     MRDOCS_TRY(auto const cmakePath, getCmakePath());
 
+    // ------------------------------------------------------
+    // Reuse the cached build directory
+    // ------------------------------------------------------
+    // The build directory is selected by the project and
+    // the CMake arguments. It is reused as is while the
+    // CMake inputs of the project are unchanged, and
+    // configured again when any of them differ.
+    std::string cachedBuildDir;
+    std::string projectHash;
+    std::string stampPath;
+    if (!cacheDir.empty())
+    {
+        llvm::SHA1 hasher;
+        hasher.update(projectPath);
+        hasher.update(llvm::ArrayRef<std::uint8_t>{0});
+        hasher.update(cmakeArgs);
+        cachedBuildDir = files::appendPath(
+            cacheDir, "cmake", llvm::toHex(hasher.final(), true));
+        buildDir = cachedBuildDir;
+        projectHash = hashCmakeProject(projectPath, cmakePath, cmakeArgs, cacheDir);
+        stampPath = files::appendPath(cachedBuildDir, "mrdocs-project-hash.txt");
+        auto const stamp = llvm::MemoryBuffer::getFile(stampPath);
+        std::string compileCommandsPath = files::appendPath(
+            cachedBuildDir, "compile_commands.json");
+        if (stamp &&
+            stamp.get()->getBuffer() == projectHash &&
+            llvm::sys::fs::exists(compileCommandsPath))
+        {
+            report::info("Reusing the CMake build directory \"{}\"", cachedBuildDir);
+            return compileCommandsPath;
+        }
+        llvm::sys::fs::remove(stampPath);
+    }
+
     std::array<std::optional<llvm::StringRef>, 3> const redirects = {std::nullopt, std::nullopt, std::nullopt};
     std::vector<llvm::StringRef> args = {cmakePath, "-S", projectPath, "-B", buildDir, "-DCMAKE_EXPORT_COMPILE_COMMANDS=ON"};
 
     auto const additionalArgs = parseBashArgs(cmakeArgs.str());
-    MRDOCS_TRY(pushCMakeArgs(cmakePath, args, additionalArgs));
+    MRDOCS_TRY(pushCMakeArgs(cmakePath, args, additionalArgs, cacheDir));
 
     int const result = llvm::sys::ExecuteAndWait(cmakePath, args, std::nullopt, redirects);
     if (result != 0) {
@@ -482,9 +671,12 @@ executeCmakeExportCompileCommands(llvm::StringRef projectPath, llvm::StringRef c
         llvm::sys::fs::exists(compileCommandsPath),
         "CMake execution failed (no compile_commands.json file generated)");
 
+    if (!stampPath.empty())
+    {
+        writeCacheFile(stampPath, projectHash);
+    }
     return compileCommandsPath.str().str();
 }
 
-
 } // mrdocs
 } // clang
@@ -25,14 +25,26 @@ namespace mrdocs {
  * This function runs CMake in a temporary directory for the given project path 
  * to create a `compile_commands.json` file. 
  *
+ * When a cache directory is given, CMake runs in a build directory inside it,
+ * selected by the project path and the CMake arguments, and the temporary
+ * directory is not used. The build directory is reused without running CMake
+ * while the CMake executable, the CMake arguments, the CMake files and
+ * configure_file templates of the project, and the paths of its source files
+ * are unchanged. The default generator of CMake is also cached there.
+ *
  * @param projectPath The path to the project directory.
  * @param cmakeArgs The arguments to pass to CMake when generating the compilation database.
  * @param tempDir The path to the temporary directory to use for CMake execution.
+ * @param cacheDir The path to the cache directory, or empty.
  * @return An `Expected` object containing the path to the generated `compile_commands.json` file if successful.
  *         Returns `Unexpected` if the project path is not found or if CMake execution fails.
  */
 Expected<std::string>
-executeCmakeExportCompileCommands(llvm::StringRef projectPath, llvm::StringRef cmakeArgs, llvm::StringRef tempDir);
+executeCmakeExportCompileCommands(
+    llvm::StringRef projectPath,
+    llvm::StringRef cmakeArgs,
+    llvm::StringRef tempDir,
+    llvm::StringRef cacheDir = {});
 
 } // mrdocs
 } // clang
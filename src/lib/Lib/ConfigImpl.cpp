@@ -163,6 +163,10 @@ load(
 
     s.symbolFilter.finalize(false, false, false);
 
+    // Compile the input filters
+    s.inputFilter = InputFilter(
+        s.input.include, s.input.filePatterns);
+
     return c;
 }
 
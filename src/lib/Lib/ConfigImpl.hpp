@@ -13,6 +13,7 @@
 #define MRDOCS_LIB_CONFIGIMPL_HPP
 
 #include "lib/Lib/Filters.hpp"
+#include "lib/Support/Glob.hpp"
 #include "lib/Support/YamlFwd.hpp"
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Support/Error.hpp>
@@ -49,6 +50,13 @@ public:
         */
         FilterNode symbolFilter;
 
+        /** Compiled input include prefixes and file patterns.
+
+            Used during AST traversal to determine whether
+            a file is an input.
+        */
+        InputFilter inputFilter;
+
         /** Namespaces for symbols rendered as "see-below".
          */
         std::vector<FilterPattern> seeBelowFilter;
@@ -32,7 +32,7 @@ bool
 Corpus::
 empty() const noexcept
 {
-    return begin() == end();
+    return infos().empty();
 }
 
 /** Return the metadata for the global namespace.
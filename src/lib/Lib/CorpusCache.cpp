@@ -0,0 +1,367 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "CorpusCache.hpp"
+#include "lib/Metadata/Binary.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Version.hpp>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+constexpr char entryMagic[4] = { 'M', 'R', 'D', 'C' };
+
+// Options which do not change the
+// symbols extracted from a translation unit
+constexpr std::string_view ignoredOptions[] = {
+    "inputs", "config", "output", "compilation-database",
+    "cache-dir", "corpus-output", "corpus-input", "cmake",
+    "generate", "multipage", "base-url", "addons", "dom-cache",
+    "dom-cache-budget", "concurrency", "verbose", "report",
+    "ignore-map-errors", "ignore-failures", "profile-file", "trace-file"
+};
+
+std::string
+settingsKey(ConfigImpl const& config)
+{
+    std::string s;
+    PublicSettings settings = config.settings();
+    settings.visit([&]<class T>(std::string_view name, T const& value)
+    {
+        if(std::ranges::find(ignoredOptions, name) !=
+            std::end(ignoredOptions))
+            return;
+        s.append(name);
+        s.push_back('=');
+        if constexpr(std::convertible_to<T const&, std::string_view>)
+        {
+            s.append(value);
+        }
+        else if constexpr(std::same_as<T, std::vector<std::string>>)
+        {
+            for(auto const& v : value)
+            {
+                s.append(v);
+                s.push_back(',');
+            }
+        }
+        else if constexpr(std::integral<T> || std::is_enum_v<T>)
+        {
+            s.append(std::to_string(static_cast<long long>(value)));
+        }
+        s.push_back('\0');
+    });
+    return s;
+}
+
+void
+putString(BinaryWriter& w, std::string_view s)
+{
+    w.varint(s.size());
+    w.bytes(s.data(), s.size());
+}
+
+std::string
+getString(BinaryReader& r)
+{
+    std::uint64_t const size = r.varint();
+    if(size > r.remaining())
+        formatError("binary data: invalid string size {}", size).Throw();
+    std::string s(size, '\0');
+    r.bytes(s.data(), size);
+    return s;
+}
+
+} // (anon)
+
+//------------------------------------------------
+//
+// Recorder
+//
+//------------------------------------------------
+
+void
+CorpusCache::
+Recorder::
+reportDependencies(
+    std::vector<std::string> files)
+{
+    dependencies_.insert(
+        dependencies_.end(),
+        files.begin(),
+        files.end());
+    ex_.reportDependencies(std::move(files));
+}
+
+void
+CorpusCache::
+Recorder::
+report(
+    InfoSet&& info,
+    Diagnostics&& diags)
+{
+    Diagnostics copy;
+    for(auto const& [msg, is_error] : diags.messages())
+    {
+        if(is_error)
+            copy.error(msg);
+        else
+            copy.warn(msg);
+    }
+    results_.emplace_back(encodeInfoSet(info), std::move(copy));
+    ex_.report(std::move(info), std::move(diags));
+}
+
+void
+CorpusCache::
+Recorder::
+reportEnd(report::Level level)
+{
+    ex_.reportEnd(level);
+}
+
+mrdocs::Expected<InfoSet>
+CorpusCache::
+Recorder::
+results()
+{
+    return ex_.results();
+}
+
+//------------------------------------------------
+//
+// CorpusCache
+//
+//------------------------------------------------
+
+CorpusCache::
+CorpusCache(
+    std::string dir,
+    ConfigImpl const& config)
+    : dir_(std::move(dir))
+    , settings_(settingsKey(config))
+{
+}
+
+std::string
+CorpusCache::
+key(std::vector<tooling::CompileCommand> const& commands) const
+{
+    std::string s;
+    s.append(project_version);
+    s.push_back('\0');
+    s.append(std::to_string(binaryFormatVersion));
+    s.push_back('\0');
+    s.append(settings_);
+    for(auto const& cmd : commands)
+    {
+        s.append(cmd.Directory);
+        s.push_back('\0');
+        s.append(cmd.Filename);
+        s.push_back('\0');
+        for(auto const& arg : cmd.CommandLine)
+        {
+            s.append(arg);
+            s.push_back('\0');
+        }
+    }
+    return llvm::toHex(llvm::SHA1::hash(
+        llvm::arrayRefFromStringRef(s)), true);
+}
+
+std::optional<std::uint64_t>
+CorpusCache::
+fileHash(std::string const& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(auto it = fileHashes_.find(path); it != fileHashes_.end())
+            return it->second;
+    }
+    // the file is hashed outside the lock; when two
+    // threads race, both compute the same value
+    std::optional<std::uint64_t> hash;
+    if(! path.empty())
+    {
+        auto buffer = llvm::MemoryBuffer::getFile(
+            path, false, false);
+        if(buffer)
+            hash = llvm::xxHash64((*buffer)->getBuffer());
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    fileHashes_.try_emplace(path, hash);
+    return hash;
+}
+
+std::string
+CorpusCache::
+entryPath(std::string_view key) const
+{
+    std::string name(key);
+    name.append(".mrdc");
+    return files::appendPath(dir_, name);
+}
+
+bool
+CorpusCache::
+load(
+    std::string_view key,
+    ExecutionContext& ex)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(
+        entryPath(key), false, false);
+    if(! buffer)
+    {
+        ++misses_;
+        return false;
+    }
+
+    std::vector<std::string> dependencies;
+    std::vector<std::pair<InfoSet, Diagnostics>> results;
+    try
+    {
+        BinaryReader r((*buffer)->getBuffer(), {});
+        char magic[sizeof(entryMagic)];
+        r.bytes(magic, sizeof(magic));
+        if(std::memcmp(magic, entryMagic, sizeof(magic)) != 0 ||
+            r.varint() != binaryFormatVersion)
+        {
+            ++misses_;
+            return false;
+        }
+
+        // every file must have the same content
+        // as when the entry was stored
+        std::uint64_t const n = r.varint();
+        for(std::uint64_t i = 0; i < n; ++i)
+        {
+            std::string path = getString(r);
+            std::uint64_t hash;
+            r.bytes(&hash, sizeof(hash));
+            if(fileHash(path) != hash)
+            {
+                ++misses_;
+                return false;
+            }
+            dependencies.push_back(std::move(path));
+        }
+
+        std::uint64_t const count = r.varint();
+        for(std::uint64_t i = 0; i < count; ++i)
+        {
+            Diagnostics diags;
+            std::uint64_t const messages = r.varint();
+            for(std::uint64_t j = 0; j < messages; ++j)
+            {
+                bool const is_error = r.varint() != 0;
+                if(is_error)
+                    diags.error(getString(r));
+                else
+                    diags.warn(getString(r));
+            }
+            auto info = decodeInfoSet(getString(r));
+            if(! info)
+                info.error().Throw();
+            results.emplace_back(std::move(*info), std::move(diags));
+        }
+    }
+    catch(Exception const& ex)
+    {
+        report::debug("Ignoring corpus cache entry {}: {}",
+            key, ex.error().message());
+        ++misses_;
+        return false;
+    }
+
+    ex.reportDependencies(std::move(dependencies));
+    for(auto& [info, diags] : results)
+        ex.report(std::move(info), std::move(diags));
+    ++hits_;
+    return true;
+}
+
+Expected<void>
+CorpusCache::
+store(
+    std::string_view key,
+    Recorder const& recorder)
+{
+    BinaryWriter w;
+    w.bytes(entryMagic, sizeof(entryMagic));
+    w.varint(binaryFormatVersion);
+    w.varint(recorder.dependencies_.size());
+    for(auto const& path : recorder.dependencies_)
+    {
+        // results which depend on a file that
+        // cannot be read are never stored
+        std::optional<std::uint64_t> hash = fileHash(path);
+        if(! hash)
+            return {};
+        putString(w, path);
+        w.bytes(&*hash, sizeof(*hash));
+    }
+    w.varint(recorder.results_.size());
+    for(auto const& [info, diags] : recorder.results_)
+    {
+        w.varint(diags.messages().size());
+        for(auto const& [msg, is_error] : diags.messages())
+        {
+            w.varint(is_error);
+            putString(w, msg);
+        }
+        putString(w, info);
+    }
+
+    if(auto ec = llvm::sys::fs::create_directories(dir_))
+        return Unexpected(formatError(
+            "fs::create_directories(\"{}\") returned {}", dir_, ec));
+
+    // write to a temporary file first, so
+    // readers never see a partial entry
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if(auto ec = llvm::sys::fs::createUniqueFile(
+        files::appendPath(dir_, "%%%%%%%%.tmp"), fd, tempPath))
+        return Unexpected(formatError(
+            "fs::createUniqueFile(\"{}\") returned {}", dir_, ec));
+    {
+        llvm::raw_fd_ostream os(fd, true);
+        os << w.data();
+        if(os.has_error())
+        {
+            os.clear_error();
+            llvm::sys::fs::remove(tempPath);
+            return Unexpected(formatError(
+                "failed to write \"{}\"", tempPath.str()));
+        }
+    }
+    std::string const path = entryPath(key);
+    if(auto ec = llvm::sys::fs::rename(tempPath, path))
+    {
+        llvm::sys::fs::remove(tempPath);
+        return Unexpected(formatError(
+            "fs::rename(\"{}\") returned {}", path, ec));
+    }
+    return {};
+}
+
+} // mrdocs
+} // clang
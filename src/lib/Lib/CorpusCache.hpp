@@ -0,0 +1,168 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_CORPUSCACHE_HPP
+#define MRDOCS_LIB_LIB_CORPUSCACHE_HPP
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/Diagnostics.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** An on-disk cache of the results of translation units.
+
+    Each entry holds the symbols and diagnostics
+    of one translation unit, and the content hash
+    of every file the translation unit read.
+
+    Entries are keyed by a hash of the compile
+    commands of the translation unit and of the
+    options that affect extraction. An entry is
+    only used when all of its files still have
+    the same content.
+*/
+class CorpusCache
+{
+public:
+    /** Records the results of a translation unit.
+
+        The results are forwarded to another
+        execution context, and a copy is kept
+        so it can be stored in the cache.
+
+        The registry of header declarations is
+        not forwarded, because the entry of a
+        translation unit must hold all of its
+        declarations.
+    */
+    class Recorder
+        : public ExecutionContext
+    {
+        friend class CorpusCache;
+
+        ExecutionContext& ex_;
+        std::vector<std::string> dependencies_;
+        std::vector<std::pair<std::string, Diagnostics>> results_;
+
+    public:
+        Recorder(
+            ConfigImpl const& config,
+            ExecutionContext& ex) noexcept
+            : ExecutionContext(config)
+            , ex_(ex)
+        {
+        }
+
+        void
+        reportDependencies(
+            std::vector<std::string> files) override;
+
+        void
+        report(
+            InfoSet&& info,
+            Diagnostics&& diags) override;
+
+        BuildProfile*
+        profile() noexcept override
+        {
+            return ex_.profile();
+        }
+
+        void
+        reportEnd(report::Level level) override;
+
+        mrdocs::Expected<InfoSet>
+        results() override;
+    };
+
+    /** Constructor.
+
+        @param dir The directory of the cache.
+        @param config The configuration.
+    */
+    CorpusCache(
+        std::string dir,
+        ConfigImpl const& config);
+
+    /** Return the key for the compile commands of a file.
+    */
+    std::string
+    key(std::vector<tooling::CompileCommand> const& commands) const;
+
+    /** Report the cached results of a translation unit.
+
+        @return `true` if a valid entry was found
+        and its results were reported to `ex`.
+
+        @param key The key of the translation unit.
+        @param ex The execution context.
+    */
+    bool
+    load(
+        std::string_view key,
+        ExecutionContext& ex);
+
+    /** Store the recorded results of a translation unit.
+
+        @param key The key of the translation unit.
+        @param recorder The recorded results.
+    */
+    Expected<void>
+    store(
+        std::string_view key,
+        Recorder const& recorder);
+
+    /** Return the number of translation units loaded from the cache.
+    */
+    std::size_t
+    hits() const noexcept
+    {
+        return hits_;
+    }
+
+    /** Return the number of translation units not found in the cache.
+    */
+    std::size_t
+    misses() const noexcept
+    {
+        return misses_;
+    }
+
+private:
+    std::optional<std::uint64_t>
+    fileHash(std::string const& path);
+
+    std::string
+    entryPath(std::string_view key) const;
+
+    std::string dir_;
+    std::string settings_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::optional<std::uint64_t>> fileHashes_;
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -11,58 +11,31 @@
 //
 
 #include "CorpusImpl.hpp"
+#include "lib/Lib/CorpusCache.hpp"
 #include "lib/AST/ASTVisitor.hpp"
+#include "lib/Metadata/Binary.hpp"
 #include "lib/Metadata/Finalize.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include "lib/Support/Chrono.hpp"
 #include "lib/Support/Error.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
 #include <chrono>
 
 namespace clang {
 namespace mrdocs {
 
-auto
-CorpusImpl::
-begin() const noexcept ->
-    iterator
-{
-    if(info_.empty())
-        return end();
-    // KRYSTIAN NOTE: this is far from ideal, but i'm not sure
-    // to what extent implementation detail should be hidden.
-    return iterator(this, info_.begin()->get(),
-        [](const Corpus* corpus, const Info* val) ->
-            const Info*
-        {
-            MRDOCS_ASSERT(val);
-            const CorpusImpl* impl =
-                static_cast<const CorpusImpl*>(corpus);
-            auto it = impl->info_.find(val->id);
-            if(++it == impl->info_.end())
-                return nullptr;
-            return it->get();
-        });
-}
-
-auto
-CorpusImpl::
-end() const noexcept ->
-    iterator
-{
-    return iterator();
-}
-
 Info*
 CorpusImpl::
 find(
     SymbolID const& id) noexcept
 {
-    auto it = info_.find(id);
-    if(it != info_.end())
-        return it->get();
-    return nullptr;
+    return table_.find(id);
 }
 
 Info const*
@@ -70,33 +43,61 @@ CorpusImpl::
 find(
     SymbolID const& id) const noexcept
 {
-    auto it = info_.find(id);
-    if(it != info_.end())
-        return it->get();
-    return nullptr;
+    return table_.find(id);
 }
 
-//------------------------------------------------
+std::string_view
+CorpusImpl::
+qualifiedName(Info const& I) const noexcept
+{
+    std::uint32_t const index = table_.indexOf(I.id);
+    MRDOCS_ASSERT(index < qualifiedNames_.size());
+    return qualifiedNames_[index];
+}
 
-namespace {
-template <class Rep, class Period>
-std::string
-format_duration(
-    std::chrono::duration<Rep, Period> delta)
+std::vector<Error>
+CorpusImpl::
+buildQualifiedNames()
 {
-    auto delta_ms = std::chrono::duration_cast<
-        std::chrono::milliseconds>(delta).count();
-    if (delta_ms < 1000)
-    {
-        return fmt::format("{} ms", delta_ms);
-    }
-    else
+    constexpr std::size_t chunkSize = 4096;
+    auto const infos = table_.infos();
+    std::size_t const chunks =
+        (infos.size() + chunkSize - 1) / chunkSize;
+    qualifiedNames_.assign(infos.size(), {});
+    qualifiedNameBuffers_.assign(chunks, {});
+
+    TaskGroup taskGroup(config_->threadPool());
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
     {
-        double const delta_s = static_cast<double>(delta_ms) / 1000.0;
-        return fmt::format("{:.02f} s", delta_s);
+        taskGroup.async([this, infos, chunk]
+        {
+            std::size_t const first = chunk * chunkSize;
+            std::size_t const last =
+                std::min(first + chunkSize, infos.size());
+            std::string& buffer = qualifiedNameBuffers_[chunk];
+            std::vector<std::size_t> ends;
+            ends.reserve(last - first);
+            std::string temp;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                buffer.append(getFullyQualifiedName(*infos[i], temp));
+                ends.push_back(buffer.size());
+            }
+            // the buffer is complete, so views of it stay valid
+            std::string_view const names(buffer);
+            std::size_t begin = 0;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                std::size_t const end = ends[i - first];
+                qualifiedNames_[i] = names.substr(begin, end - begin);
+                begin = end;
+            }
+        });
     }
+    return taskGroup.wait();
 }
-}
+
+//------------------------------------------------
 
 mrdocs::Expected<std::unique_ptr<Corpus>>
 CorpusImpl::
@@ -123,18 +124,56 @@ build(
     // InfoSet in the execution context.
     InfoExecutionContext context(*config);
 
+    // ------------------------------------------
+    // Precompiled preambles
+    // ------------------------------------------
+    // When enabled, translation units with the
+    // same preamble share a precompiled one.
+    std::optional<PreambleCache> preambles;
+    if ((*config)->reusePreambles)
+    {
+        preambles.emplace();
+    }
+    PreambleCache* const preamblesPtr =
+        preambles ? &*preambles : nullptr;
+
     // Create an `ASTActionFactory` to create multiple
     // `ASTAction`s that extract the AST for each translation unit.
     std::unique_ptr<tooling::FrontendActionFactory> action =
-        makeFrontendActionFactory(context, *config);
+        makeFrontendActionFactory(context, *config, preamblesPtr);
     MRDOCS_ASSERT(action);
 
+    // ------------------------------------------
+    // Translation unit cache
+    // ------------------------------------------
+    // When enabled, the results of unchanged
+    // translation units are loaded from disk.
+    std::optional<CorpusCache> cache;
+    if (!(*config)->cacheDir.empty())
+    {
+        cache.emplace((*config)->cacheDir, *config);
+    }
+
     // ------------------------------------------
     // "Process file" task
     // ------------------------------------------
     auto const processFile =
         [&](std::string path)
         {
+            trace::Span span("Translation unit");
+            span.arg("file", path);
+
+            std::string key;
+            if (cache)
+            {
+                key = cache->key(compilations.getCompileCommands(path));
+                if (cache->load(key, context))
+                {
+                    span.arg("cached", std::int64_t(1));
+                    return;
+                }
+            }
+
             // Each thread gets an independent copy of a VFS to allow different
             // concurrent working directories.
             IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
@@ -148,10 +187,27 @@ build(
             // Suppress error messages from the tool
             Tool.setPrintErrorMessage(false);
 
-            if (Tool.run(action.get()))
+            if (!cache)
+            {
+                if (Tool.run(action.get()))
+                {
+                    formatError("Failed to run action on {}", path).Throw();
+                }
+                return;
+            }
+
+            // Record the results so they can be stored
+            CorpusCache::Recorder recorder(*config, context);
+            std::unique_ptr<tooling::FrontendActionFactory> recordAction =
+                makeFrontendActionFactory(recorder, *config, preamblesPtr);
+            if (Tool.run(recordAction.get()))
             {
                 formatError("Failed to run action on {}", path).Throw();
             }
+            if (auto exp = cache->store(key, recorder); !exp)
+            {
+                report::warn("Failed to cache {}: {}", path, exp.error());
+            }
         };
 
     // ------------------------------------------
@@ -160,6 +216,7 @@ build(
     // Traverse the AST for all translation units.
     // This operation happens on a thread pool.
     report::print(reportLevel, "Extracting declarations");
+    trace::Span extractSpan("Extract declarations");
 
     // Get a copy of the filename strings
     std::vector<std::string> files = compilations.getAllFiles();
@@ -194,9 +251,45 @@ build(
         }
         errors = taskGroup.wait();
     }
+    extractSpan.arg("files", static_cast<std::int64_t>(files.size()));
+    extractSpan.end();
+
     // Print diagnostics totals
     context.reportEnd(reportLevel);
 
+    if (cache)
+    {
+        report::log(reportLevel,
+            "Loaded {} of {} translation units from the cache",
+            cache->hits(), cache->hits() + cache->misses());
+    }
+    if (preambles)
+    {
+        std::size_t const total = preambles->hits() + preambles->misses();
+        report::log(reportLevel,
+            "Used {} precompiled preambles for {} of {} translation units, "
+            "saving about {} of parsing",
+            preambles->built(), preambles->hits(), total,
+            format_duration(preambles->saved()));
+    }
+    if (HeaderDeclRegistry const* headerDecls = context.headerDecls())
+    {
+        report::log(reportLevel,
+            "Extracted {} header declarations, skipped {} extracted "
+            "by other translation units",
+            headerDecls->built(), headerDecls->skipped());
+    }
+    if (BuildProfile const* profile = context.profile())
+    {
+        // the profile was requested, so always show it
+        profile->print(report::Level::info, 10);
+        if (auto exp = profile->write((*config)->profileFile); !exp)
+        {
+            report::warn("Failed to write the build profile: {}",
+                exp.error());
+        }
+    }
+
     // ------------------------------------------
     // Report warning and error totals
     // ------------------------------------------
@@ -215,6 +308,8 @@ build(
     if(! results)
         return Unexpected(results.error());
     corpus->info_ = std::move(results.value());
+    // finalize does not add or remove symbols
+    corpus->table_ = SymbolTable(corpus->info_);
 
     report::log(reportLevel,
         "Extracted {} declarations in {}",
@@ -224,11 +319,94 @@ build(
     // ------------------------------------------
     // Finalize corpus
     // ------------------------------------------
+    // The lookup is read-only once built, and each
+    // symbol is finalized independently on the pool.
+    auto const finalize_start = clock_type::now();
+    trace::Span lookupSpan("Build symbol lookup");
     auto lookup = std::make_unique<SymbolLookup>(*corpus);
-    finalize(corpus->info_, *lookup);
+    lookupSpan.end();
+    auto const lookup_time = clock_type::now() - finalize_start;
+    trace::Span finalizeSpan("Finalize");
+    auto finalizeErrors = finalize(
+        corpus->info_, *lookup, config->threadPool());
+    finalizeSpan.end();
+    if (!finalizeErrors.empty())
+    {
+        return Unexpected(Error(finalizeErrors));
+    }
+
+    report::log(reportLevel,
+        "Finalized {} declarations in {} ({} building the symbol lookup)",
+        corpus->info_.size(),
+        format_duration(clock_type::now() - finalize_start),
+        format_duration(lookup_time));
+
+    // the symbols do not change once finalized
+    trace::Span namesSpan("Build qualified names");
+    if (auto errors = corpus->buildQualifiedNames(); !errors.empty())
+    {
+        return Unexpected(Error(errors));
+    }
+    namesSpan.end();
 
     return corpus;
 }
 
+mrdocs::Expected<std::unique_ptr<Corpus>>
+CorpusImpl::
+load(
+    report::Level reportLevel,
+    std::shared_ptr<ConfigImpl const> const& config,
+    std::string_view path)
+{
+    using clock_type = std::chrono::steady_clock;
+    auto start_time = clock_type::now();
+
+    // the file is memory mapped when it is large enough
+    auto buffer = llvm::MemoryBuffer::getFile(path, false, false);
+    if (!buffer)
+    {
+        return Unexpected(formatError(
+            "Failed to open corpus file \"{}\": {}",
+            path, buffer.getError()));
+    }
+    MRDOCS_TRY(CorpusView view, CorpusView::create((*buffer)->getBuffer()));
+
+    std::unique_ptr<CorpusImpl> corpus = std::make_unique<CorpusImpl>(config);
+    MRDOCS_TRY(corpus->info_, view.readAll());
+    corpus->table_ = SymbolTable(corpus->info_);
+    if (auto errors = corpus->buildQualifiedNames(); !errors.empty())
+    {
+        return Unexpected(Error(errors));
+    }
+
+    report::log(reportLevel,
+        "Loaded {} declarations from \"{}\" in {}",
+        corpus->info_.size(), path,
+        format_duration(clock_type::now() - start_time));
+    return corpus;
+}
+
+mrdocs::Expected<void>
+CorpusImpl::
+save(std::string_view path) const
+{
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_None);
+    if (ec)
+    {
+        return Unexpected(formatError(
+            "Failed to open \"{}\": {}", path, ec));
+    }
+    os << encodeCorpus(info_);
+    os.close();
+    if (os.has_error())
+    {
+        os.clear_error();
+        return Unexpected(formatError("Failed to write \"{}\"", path));
+    }
+    return {};
+}
+
 } // mrdocs
 } // clang
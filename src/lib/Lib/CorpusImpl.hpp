@@ -13,6 +13,7 @@
 
 #include "lib/Lib/ConfigImpl.hpp"
 #include "lib/Lib/Info.hpp"
+#include "lib/Lib/SymbolTable.hpp"
 #include "lib/Support/Debug.hpp"
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata.hpp>
@@ -21,6 +22,8 @@
 #include <clang/Tooling/CompilationDatabase.h>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -49,15 +52,23 @@ public:
     {
     }
 
-    /** Iterator to the first Info.
+    /** Return the index of all symbols.
     */
-    iterator
-    begin() const noexcept override;
+    std::span<Info const* const>
+    infos() const noexcept override
+    {
+        return table_.infos();
+    }
 
-    /** Iterator to one past the last Info.
+    /** Return the position of a symbol in the index.
     */
-    iterator
-    end() const noexcept override;
+    std::size_t
+    indexOf(SymbolID const& id) const noexcept override
+    {
+        // a missing symbol has the index -1
+        std::size_t const index = table_.indexOf(id);
+        return index < table_.size() ? index : table_.size();
+    }
 
     /** Return the Info with the specified symbol ID.
 
@@ -67,6 +78,11 @@ public:
     find(
         SymbolID const& id) noexcept;
 
+    /** Return the fully qualified name of the specified Info.
+    */
+    std::string_view
+    qualifiedName(Info const& I) const noexcept override;
+
     /** Build metadata for a set of translation units.
 
         This is the main point of interaction between MrDocs
@@ -92,6 +108,32 @@ public:
         std::shared_ptr<ConfigImpl const> const& config,
         tooling::CompilationDatabase const& compilations);
 
+    /** Load a corpus file.
+
+        The file must have been written by
+        @ref save. The symbols are loaded as
+        they were saved, so they are not
+        finalized again.
+
+        @param reportLevel Error reporting level.
+        @param config A shared pointer to the configuration.
+        @param path The path of the corpus file.
+    */
+    [[nodiscard]]
+    static
+    mrdocs::Expected<std::unique_ptr<Corpus>>
+    load(
+        report::Level reportLevel,
+        std::shared_ptr<ConfigImpl const> const& config,
+        std::string_view path);
+
+    /** Save the corpus to a file.
+
+        @param path The path of the corpus file.
+    */
+    mrdocs::Expected<void>
+    save(std::string_view path) const;
+
 private:
     Info const*
     find(
@@ -113,6 +155,20 @@ private:
 
     // Info keyed on Symbol ID.
     InfoSet info_;
+
+    // Flat index of info_, built once
+    // all the symbols are extracted.
+    SymbolTable table_;
+
+    // The fully qualified name of each symbol, in
+    // the order of table_. The names of each chunk
+    // of symbols are stored in a single buffer.
+    std::vector<std::string_view> qualifiedNames_;
+    std::vector<std::string> qualifiedNameBuffers_;
+
+    [[nodiscard]]
+    std::vector<Error>
+    buildQualifiedNames();
 };
 
 template<class T>
@@ -63,6 +63,18 @@ public:
         messages_.emplace(std::move(s), false);
     }
 
+    /** Return the accumulated messages.
+
+        Each message is mapped to `true` if
+        it is an error, or `false` if it is
+        a warning.
+    */
+    std::unordered_map<std::string, bool> const&
+    messages() const noexcept
+    {
+        return messages_;
+    }
+
     /** Print the accumulated diagnostics.
 
         This function prints the accumulated diagnostics
@@ -13,7 +13,9 @@
 
 #include "ExecutionContext.hpp"
 #include "lib/Metadata/Reduce.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <chrono>
 #include <ranges>
 
 namespace clang {
@@ -77,6 +79,10 @@ report(
     InfoSet&& results,
     Diagnostics&& diags)
 {
+    using clock_type = std::chrono::steady_clock;
+    trace::Span span("Merge results");
+    span.arg("infos", static_cast<std::int64_t>(results.size()));
+
     InfoSet info = std::move(results);
     // KRYSTIAN TODO: read stage will be required to
     // update Info references once we switch to using Info*
@@ -86,7 +92,11 @@ report(
     }
     #endif
 
+    auto const start = clock_type::now();
     std::unique_lock<std::shared_mutex> write_lock(mutex_);
+    span.arg("lock wait ms", trace::toMilliseconds(
+        clock_type::now() - start));
+
     // Add all new Info to the existing set.
     info_.merge(info);
 
@@ -97,6 +107,7 @@ report(
         MRDOCS_ASSERT(it != info_.end());
         merge(**it, std::move(*other));
     }
+    span.arg("duplicates", static_cast<std::int64_t>(info.size()));
 
     // Merge diagnostics and report any new messages.
     diags_.mergeAndReport(std::move(diags));
@@ -13,8 +13,10 @@
 #ifndef MRDOCS_LIB_TOOL_EXECUTIONCONTEXT_HPP
 #define MRDOCS_LIB_TOOL_EXECUTIONCONTEXT_HPP
 
+#include "BuildProfile.hpp"
 #include "ConfigImpl.hpp"
 #include "Diagnostics.hpp"
+#include "HeaderDeclRegistry.hpp"
 #include "Info.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <llvm/ADT/SmallString.h>
@@ -83,6 +85,49 @@ public:
         InfoSet&& info,
         Diagnostics&& diags) = 0;
 
+    /** Adds the files a translation unit depends on.
+
+        This function is called for each translation
+        unit, before its results are reported, with
+        the main file and every file it included.
+
+        The default implementation does nothing.
+
+        @param files The paths of the files.
+    */
+    virtual
+    void
+    reportDependencies(
+        std::vector<std::string> files)
+    {
+    }
+
+    /** Returns the registry of declarations extracted from headers.
+
+        The default implementation returns `nullptr`,
+        and every translation unit extracts all the
+        declarations of the headers it includes.
+    */
+    virtual
+    HeaderDeclRegistry*
+    headerDecls() noexcept
+    {
+        return nullptr;
+    }
+
+    /** Returns the profile of the build.
+
+        The default implementation returns `nullptr`,
+        and the cost of translation units is not
+        recorded.
+    */
+    virtual
+    BuildProfile*
+    profile() noexcept
+    {
+        return nullptr;
+    }
+
     /** Called when the execution is complete.
 
         Report the number of errors and warnings
@@ -120,9 +165,42 @@ class InfoExecutionContext
     std::shared_mutex mutex_;
     Diagnostics diags_;
     InfoSet info_;
+    std::unique_ptr<HeaderDeclRegistry> headerDecls_;
+    std::unique_ptr<BuildProfile> profile_;
 
 public:
-    using ExecutionContext::ExecutionContext;
+    /** Initializes a context
+
+        @param config The configuration to use.
+    */
+    explicit
+    InfoExecutionContext(
+        const ConfigImpl& config)
+        : ExecutionContext(config)
+    {
+        if (config->deduplicateHeaders)
+        {
+            headerDecls_ = std::make_unique<HeaderDeclRegistry>();
+        }
+        if (!config->profileFile.empty())
+        {
+            profile_ = std::make_unique<BuildProfile>();
+        }
+    }
+
+    /// @copydoc ExecutionContext::headerDecls
+    HeaderDeclRegistry*
+    headerDecls() noexcept override
+    {
+        return headerDecls_.get();
+    }
+
+    /// @copydoc ExecutionContext::profile
+    BuildProfile*
+    profile() noexcept override
+    {
+        return profile_.get();
+    }
 
     /// @copydoc ExecutionContext::report
     void
@@ -0,0 +1,36 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "HeaderDeclRegistry.hpp"
+
+namespace clang {
+namespace mrdocs {
+
+bool
+HeaderDeclRegistry::
+contains(Key const& key) const
+{
+    Shard const& shard = shards_[shardIndex(key)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.keys.contains(key);
+}
+
+void
+HeaderDeclRegistry::
+insert(std::span<Key const> keys)
+{
+    for(Key const& key : keys)
+    {
+        Shard& shard = shards_[shardIndex(key)];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.keys.insert(key);
+    }
+}
+
+} // mrdocs
+} // clang
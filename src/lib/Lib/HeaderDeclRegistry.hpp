@@ -0,0 +1,140 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_HEADERDECLREGISTRY_HPP
+#define MRDOCS_LIB_LIB_HEADERDECLREGISTRY_HPP
+
+#include <mrdocs/Metadata/Symbols.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_set>
+
+namespace clang {
+namespace mrdocs {
+
+/** The declarations already extracted from headers.
+
+    When several translation units include the
+    same header, each of them would extract the
+    same declarations from it, only for the
+    results to be merged. The registry records
+    the declarations which a translation unit
+    extracted from a header, so the translation
+    units which are processed later can skip them.
+
+    A declaration is identified by its SymbolID
+    and by a hash of the file where it is declared,
+    which covers the contents of the file and the
+    macros it consults, so a declaration is
+    extracted again when the header is different
+    or is included after different macros.
+
+    The registry can be used concurrently.
+*/
+class HeaderDeclRegistry
+{
+public:
+    /** A declaration in a file.
+    */
+    struct Key
+    {
+        /** The hash of the file and of its macros.
+        */
+        std::uint64_t file = 0;
+
+        /** The SymbolID of the declaration.
+        */
+        SymbolID id;
+
+        bool operator==(Key const&) const noexcept = default;
+    };
+
+    /** Return true if the declaration was extracted.
+    */
+    bool
+    contains(Key const& key) const;
+
+    /** Add declarations extracted by a translation unit.
+    */
+    void
+    insert(std::span<Key const> keys);
+
+    /** Count declarations which were extracted.
+    */
+    void
+    addBuilt(std::size_t n) noexcept
+    {
+        built_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** Count declarations which were skipped.
+    */
+    void
+    addSkipped(std::size_t n) noexcept
+    {
+        skipped_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** Return the number of declarations which were extracted.
+    */
+    std::size_t
+    built() const noexcept
+    {
+        return built_.load(std::memory_order_relaxed);
+    }
+
+    /** Return the number of declarations which were skipped.
+    */
+    std::size_t
+    skipped() const noexcept
+    {
+        return skipped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct KeyHasher
+    {
+        std::size_t
+        operator()(Key const& key) const noexcept
+        {
+            // the SymbolID is a SHA1, so its
+            // bytes are already well distributed
+            std::size_t h;
+            std::memcpy(&h, key.id.data(), sizeof(h));
+            return h ^ key.file;
+        }
+    };
+
+    static constexpr std::size_t shardCount = 16;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_set<Key, KeyHasher> keys;
+    };
+
+    static
+    std::size_t
+    shardIndex(Key const& key) noexcept
+    {
+        return key.id.data()[1] % shardCount;
+    }
+
+    Shard shards_[shardCount];
+    std::atomic<std::size_t> built_ = 0;
+    std::atomic<std::size_t> skipped_ = 0;
+};
+
+} // mrdocs
+} // clang
+
+#endif
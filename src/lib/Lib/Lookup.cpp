@@ -10,6 +10,7 @@
 
 #include "Lookup.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <llvm/Support/MathExtras.h>
 
 namespace clang {
 namespace mrdocs {
@@ -80,6 +81,48 @@ LookupTable(
     MRDOCS_ASSERT(supportsLookup(&info));
 
     buildLookups(corpus, info, *this);
+    if(lookups_.empty())
+        return;
+    // symbols with the same name stay in member order
+    std::ranges::stable_sort(lookups_,
+        std::ranges::less{}, &value_type::first);
+
+    std::size_t groups = 0;
+    for(std::size_t i = 0; i < lookups_.size(); ++i)
+        groups += i == 0 || lookups_[i].first != lookups_[i - 1].first;
+    slots_.resize(llvm::PowerOf2Ceil(2 * groups));
+    std::size_t const mask = slots_.size() - 1;
+    for(std::size_t i = 0; i < lookups_.size();)
+    {
+        std::string_view const name = lookups_[i].first;
+        std::size_t n = 1;
+        while(i + n < lookups_.size() && lookups_[i + n].first == name)
+            ++n;
+        std::size_t h = std::hash<std::string_view>()(name) & mask;
+        while(slots_[h].count)
+            h = (h + 1) & mask;
+        slots_[h] = {
+            static_cast<std::uint32_t>(i),
+            static_cast<std::uint32_t>(n)};
+        i += n;
+    }
+}
+
+std::span<const LookupTable::value_type>
+LookupTable::
+find(std::string_view name) const noexcept
+{
+    if(slots_.empty())
+        return {};
+    std::size_t const mask = slots_.size() - 1;
+    for(std::size_t h = std::hash<std::string_view>()(name) & mask;
+        slots_[h].count; h = (h + 1) & mask)
+    {
+        const Slot& slot = slots_[h];
+        if(lookups_[slot.first].first == name)
+            return {lookups_.data() + slot.first, slot.count};
+    }
+    return {};
 }
 
 SymbolLookup::
@@ -88,16 +131,39 @@ SymbolLookup(const Corpus& corpus)
 {
     for(const Info& I : corpus_)
     {
+        if(I.isTypedef())
+            typedefs_.emplace(&I, resolveTypedef(&I));
         if(! supportsLookup(&I))
             continue;
-        lookup_tables_.emplace(&I, LookupTable(I, corpus_));
+        // the lookup table itself is built on first use
+        LookupContext& context = contexts_[&I];
+        if(! I.isRecord())
+            continue;
+        const auto& RI = static_cast<const RecordInfo&>(I);
+        context.bases.reserve(RI.Bases.size());
+        for(const auto& B : RI.Bases)
+            context.bases.push_back(
+                corpus_.find(B.Type->namedSymbol()));
     }
 }
 
+const LookupTable&
+SymbolLookup::
+getLookupTable(
+    const LookupContext& context,
+    const Info& info) const
+{
+    std::call_once(context.once, [&]
+    {
+        context.table.emplace(info, corpus_);
+    });
+    return *context.table;
+}
+
 const Info*
 SymbolLookup::
 adjustLookupContext(
-    const Info* context)
+    const Info* context) const
 {
     // find the innermost enclosing context that supports name lookup
     while(! supportsLookup(context))
@@ -111,29 +177,39 @@ adjustLookupContext(
 
 const Info*
 SymbolLookup::
-lookThroughTypedefs(const Info* I)
+resolveTypedef(const Info* I) const
 {
     if(! I || ! I->isTypedef())
         return I;
     auto* TI = static_cast<const TypedefInfo*>(I);
-    return lookThroughTypedefs(
+    return resolveTypedef(
         corpus_.find(TI->Type->namedSymbol()));
 }
 
+const Info*
+SymbolLookup::
+lookThroughTypedefs(const Info* I) const
+{
+    if(! I || ! I->isTypedef())
+        return I;
+    return typedefs_.at(I);
+}
+
 const Info*
 SymbolLookup::
 lookupInContext(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     // if the lookup context is a typedef, we want to
     // lookup the name in the type it denotes
     if(! (context = lookThroughTypedefs(context)))
         return nullptr;
     MRDOCS_ASSERT(supportsLookup(context));
-    LookupTable& table = lookup_tables_.at(context);
+    const LookupContext& lookup_context = contexts_.at(context);
+    const LookupTable& table = getLookupTable(lookup_context, *context);
     // KRYSTIAN FIXME: disambiguation based on signature
     for(auto& result : table.lookup(name))
     {
@@ -162,18 +238,12 @@ lookupInContext(
 
     // if this is a record and nothing was found,
     // search base classes for the name
-    if(context->isRecord())
+    // KRYSTIAN FIXME: resolve ambiguities & report errors
+    for(const Info* base : lookup_context.bases)
     {
-        const auto* RI = static_cast<
-            const RecordInfo*>(context);
-        // KRYSTIAN FIXME: resolve ambiguities & report errors
-        for(const auto& B : RI->Bases)
-        {
-            if(const Info* result = lookupInContext(
-                corpus_.find(B.Type->namedSymbol()),
-                    name, for_nns, callback))
-                return result;
-        }
+        if(const Info* result = lookupInContext(
+            base, name, for_nns, callback))
+            return result;
     }
 
     return nullptr;
@@ -185,7 +255,7 @@ lookupUnqualifiedImpl(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if(! context)
         return nullptr;
@@ -209,7 +279,7 @@ lookupQualifiedImpl(
     const Info* context,
     std::span<const std::string_view> qualifier,
     std::string_view terminal,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if(! context)
         return nullptr;
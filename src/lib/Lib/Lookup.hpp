@@ -14,24 +14,45 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <ranges>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
 
 class LookupTable
 {
-    // maps unquaified names to symbols with that name.
-    // names from member symbols which are "transparent"
-    // (e.g. unscoped enums and inline namespaces) will
-    // have their members added to the table as well
-    std::unordered_multimap<
-        std::string_view, const Info*> lookups_;
+    using value_type = std::pair<
+        std::string_view, const Info*>;
+
+    // a run of symbols with the same name in lookups_
+    struct Slot
+    {
+        std::uint32_t first = 0;
+        std::uint32_t count = 0;
+    };
+
+    // unqualified names and the symbols with that name,
+    // grouped by name. names from member symbols which
+    // are "transparent" (e.g. unscoped enums and inline
+    // namespaces) will have their members added to the
+    // table as well. the names are views of Info::Name
+    std::vector<value_type> lookups_;
+
+    // open-addressed index of the groups, by name
+    std::vector<Slot> slots_;
+
+    std::span<const value_type>
+    find(std::string_view name) const noexcept;
 
 public:
     LookupTable(
@@ -40,25 +61,50 @@ public:
 
     auto lookup(std::string_view name) const
     {
-        auto [first, last] = lookups_.equal_range(name);
-        return std::ranges::subrange(
-            first, last) | std::views::values;
+        return find(name) | std::views::values;
     }
 
     void add(std::string_view name, const Info* info)
     {
-        lookups_.emplace(name, info);
+        lookups_.emplace_back(name, info);
     }
 };
 
+/** Name lookup over the symbols of a corpus.
+
+    Everything a lookup reads from the symbols
+    other than their names and parents is resolved
+    on construction, so lookups may be performed
+    concurrently while the symbols are finalized.
+    The lookup table of each context is built the
+    first time a name is looked up in it.
+*/
 class SymbolLookup
 {
     const Corpus& corpus_;
 
-    // maps symbol ID to its lookup table, if lookup is supported
+    // a symbol which supports lookup
+    struct LookupContext
+    {
+        // the symbols named by the base classes of a record,
+        // resolved on construction so that lookups do not
+        // read the types of other symbols
+        std::vector<const Info*> bases;
+
+        mutable std::once_flag once;
+        mutable std::optional<LookupTable> table;
+    };
+
+    // maps each symbol which supports lookup to its context
+    std::unordered_map<
+        const Info*,
+        LookupContext> contexts_;
+
+    // maps each typedef to the symbol it ultimately
+    // denotes, or null if it does not denote a symbol
     std::unordered_map<
         const Info*,
-        LookupTable> lookup_tables_;
+        const Info*> typedefs_;
 
     struct LookupCallback
     {
@@ -67,38 +113,46 @@ class SymbolLookup
     };
 
     template<typename Fn>
-    auto makeHandler(Fn& fn);
+    static auto makeHandler(Fn& fn);
+
+    const Info*
+    adjustLookupContext(const Info* context) const;
 
     const Info*
-    adjustLookupContext(const Info* context);
+    resolveTypedef(const Info* I) const;
 
     const Info*
-    lookThroughTypedefs(const Info* I);
+    lookThroughTypedefs(const Info* I) const;
 
     const Info*
     getTypeAsTag(
         const std::unique_ptr<TypeInfo>& T);
 
+    const LookupTable&
+    getLookupTable(
+        const LookupContext& context,
+        const Info& info) const;
+
     const Info*
     lookupInContext(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupUnqualifiedImpl(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupQualifiedImpl(
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
 public:
     SymbolLookup(const Corpus& corpus);
@@ -108,7 +162,7 @@ public:
     lookupUnqualified(
         const Info* context,
         std::string_view name,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupUnqualifiedImpl(
@@ -121,7 +175,7 @@ public:
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupQualifiedImpl(
@@ -251,7 +251,8 @@ adjustCommandLine(
     std::vector<std::string> const& stdlibIncludes,
     std::vector<std::string> const& systemIncludes,
     std::vector<std::string> const& includes,
-    bool useSystemStdlib)
+    bool useSystemStdlib,
+    std::unordered_map<std::string, std::string>& compilerTargets)
 {
     if (cmdline.empty())
     {
@@ -340,7 +341,13 @@ adjustCommandLine(
 
             if (target.empty())
             {
-                target = getCommandCompilerTarget();
+                // Each compiler is only asked once
+                auto [it, emplaced] = compilerTargets.try_emplace(progName);
+                if (emplaced)
+                {
+                    it->second = getCommandCompilerTarget();
+                }
+                target = it->second;
             }
 
 #if defined(__APPLE__)
@@ -490,6 +497,7 @@ MrDocsCompilationDatabase(
     std::vector<CompileCommand> allCommands = inner.getAllCompileCommands();
     AllCommands_.reserve(allCommands.size());
     SmallPathString temp;
+    std::unordered_map<std::string, std::string> compilerTargets;
     for (tooling::CompileCommand const& cmd0 : allCommands)
     {
         tooling::CompileCommand cmd;
@@ -504,7 +512,8 @@ MrDocsCompilationDatabase(
             (*config_impl)->stdlibIncludes,
             (*config_impl)->systemIncludes,
             (*config_impl)->includes,
-            (*config_impl)->useSystemStdlib);
+            (*config_impl)->useSystemStdlib,
+            compilerTargets);
         cmd.Directory = makeAbsoluteAndNative(workingDir, cmd0.Directory);
         cmd.Filename = makeAbsoluteAndNative(workingDir, cmd0.Filename);
         if (isCXXSrcFile(cmd.Filename))
@@ -0,0 +1,43 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/SymbolTable.hpp"
+#include <llvm/Support/MathExtras.h>
+#include <algorithm>
+
+namespace clang {
+namespace mrdocs {
+
+SymbolTable::
+SymbolTable(InfoSet const& info)
+{
+    infos_.reserve(info.size());
+    for(auto const& I : info)
+        infos_.push_back(I.get());
+    // the order of the set depends on its hash,
+    // so the indices are assigned in ID order
+    std::ranges::sort(infos_, std::less<>(),
+        [](Info const* I) -> SymbolID const& { return I->id; });
+
+    // keep the load factor at or below one half
+    std::size_t const capacity =
+        llvm::PowerOf2Ceil(std::max<std::size_t>(infos_.size() * 2, 16));
+    slots_.assign(capacity, Slot{0, empty});
+    mask_ = capacity - 1;
+    for(std::uint32_t index = 0; index < infos_.size(); ++index)
+    {
+        std::uint64_t const key = keyOf(infos_[index]->id);
+        std::size_t i = key & mask_;
+        while(slots_[i].index != empty)
+            i = (i + 1) & mask_;
+        slots_[i] = Slot{key, index};
+    }
+}
+
+} // mrdocs
+} // clang
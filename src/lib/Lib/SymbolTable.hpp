@@ -0,0 +1,119 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_SYMBOLTABLE_HPP
+#define MRDOCS_LIB_LIB_SYMBOLTABLE_HPP
+
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Metadata/Info.hpp>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** A flat index of the symbols of a corpus.
+
+    Each symbol is given a dense index, in the order
+    of the symbol IDs. The symbols are found with an
+    open-addressed table keyed by the first 8 bytes of
+    their ID, which stores the key next to the index so
+    that probing never dereferences a symbol.
+
+    The table refers to the symbols of an @ref InfoSet,
+    which must not change while the table is used.
+*/
+class SymbolTable
+{
+    struct Slot
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    static constexpr std::uint32_t empty = ~std::uint32_t(0);
+
+    std::vector<Info*> infos_;
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+
+    static
+    std::uint64_t
+    keyOf(SymbolID const& id) noexcept
+    {
+        std::uint64_t key;
+        std::memcpy(&key, id.data(), sizeof(key));
+        return key;
+    }
+
+public:
+    /** Constructor.
+
+        The table is empty.
+    */
+    SymbolTable() = default;
+
+    /** Constructor.
+
+        @param info The symbols to index.
+    */
+    explicit
+    SymbolTable(InfoSet const& info);
+
+    /** Return the symbols, ordered by their dense index.
+    */
+    std::span<Info* const>
+    infos() const noexcept
+    {
+        return infos_;
+    }
+
+    /** Return the number of symbols.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return infos_.size();
+    }
+
+    /** Return the dense index of a symbol, or -1 if it is not found.
+    */
+    std::uint32_t
+    indexOf(SymbolID const& id) const noexcept
+    {
+        if(slots_.empty())
+            return empty;
+        std::uint64_t const key = keyOf(id);
+        for(std::size_t i = key & mask_;; i = (i + 1) & mask_)
+        {
+            Slot const& slot = slots_[i];
+            if(slot.index == empty)
+                return empty;
+            if(slot.key == key &&
+                infos_[slot.index]->id == id)
+                return slot.index;
+        }
+    }
+
+    /** Return the symbol with an ID, or null if it is not found.
+    */
+    Info*
+    find(SymbolID const& id) const noexcept
+    {
+        std::uint32_t const index = indexOf(id);
+        return index != empty ? infos_[index] : nullptr;
+    }
+};
+
+} // mrdocs
+} // clang
+
+#endif
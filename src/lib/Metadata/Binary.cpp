@@ -0,0 +1,1263 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "Binary.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <llvm/Support/Endian.h>
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace clang {
+namespace mrdocs {
+
+//------------------------------------------------
+//
+// BinaryWriter
+//
+//------------------------------------------------
+
+void
+BinaryWriter::
+varint(std::uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        out_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out_.push_back(static_cast<char>(value));
+}
+
+void
+BinaryWriter::
+bytes(void const* data, std::size_t size)
+{
+    out_.append(static_cast<char const*>(data), size);
+}
+
+void
+BinaryWriter::
+string(std::string_view s)
+{
+    auto [it, inserted] = index_.try_emplace(
+        s, static_cast<std::uint32_t>(strings_.size()));
+    if(inserted)
+        strings_.push_back(it->getKey());
+    varint(it->getValue());
+}
+
+//------------------------------------------------
+//
+// BinaryReader
+//
+//------------------------------------------------
+
+std::uint64_t
+BinaryReader::
+varint()
+{
+    std::uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(it_ == end_)
+            formatError("binary data: unexpected end of data").Throw();
+        auto const byte = static_cast<unsigned char>(*it_++);
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if(! (byte & 0x80))
+            return value;
+    }
+    formatError("binary data: invalid integer").Throw();
+}
+
+void
+BinaryReader::
+bytes(void* data, std::size_t size)
+{
+    if(remaining() < size)
+        formatError("binary data: unexpected end of data").Throw();
+    std::memcpy(data, it_, size);
+    it_ += size;
+}
+
+std::string_view
+BinaryReader::
+string()
+{
+    std::uint64_t const i = varint();
+    if(i >= strings_.size())
+        formatError("binary data: invalid string index {}", i).Throw();
+    return strings_[i];
+}
+
+//------------------------------------------------
+//
+// Encoding
+//
+// Every type is encoded by a function template
+// `io`, used by both the BinaryWriter and the
+// BinaryReader, so that the encoding and the
+// decoding cannot disagree. The writer casts
+// away the constness of the objects it encodes
+// but it never modifies them.
+//
+//------------------------------------------------
+
+namespace {
+
+template<class Ar, class T>
+requires std::integral<T> || std::is_enum_v<T>
+void
+io(Ar& ar, T& v)
+{
+    if constexpr(Ar::reading)
+        v = static_cast<T>(ar.varint());
+    else
+        ar.varint(static_cast<std::uint64_t>(v));
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::string& s)
+{
+    if constexpr(Ar::reading)
+        s = ar.string();
+    else
+        ar.string(s);
+}
+
+template<class Ar>
+void
+io(Ar& ar, SymbolID& id)
+{
+    if constexpr(Ar::reading)
+    {
+        std::uint8_t data[20];
+        ar.bytes(data, sizeof(data));
+        id = SymbolID(data);
+    }
+    else
+    {
+        ar.bytes(id.data(), id.size());
+    }
+}
+
+// Declarations of the overloads for class
+// types, which are found by the containers
+// before they are defined.
+template<class Ar> void io(Ar& ar, Location& loc);
+template<class Ar> void io(Ar& ar, Param& P);
+template<class Ar> void io(Ar& ar, BaseInfo& B);
+template<class Ar> void io(Ar& ar, std::unique_ptr<NameInfo>& p);
+template<class Ar> void io(Ar& ar, std::unique_ptr<TypeInfo>& p);
+template<class Ar> void io(Ar& ar, std::unique_ptr<TArg>& p);
+template<class Ar> void io(Ar& ar, std::unique_ptr<TParam>& p);
+
+template<class Ar, class NodeTy>
+requires std::derived_from<NodeTy, doc::Node>
+void io(Ar& ar, std::unique_ptr<NodeTy>& p);
+
+template<class Ar, class T>
+void
+io(Ar& ar, std::optional<T>& v)
+{
+    bool engaged = v.has_value();
+    io(ar, engaged);
+    if constexpr(Ar::reading)
+    {
+        if(! engaged)
+        {
+            v.reset();
+            return;
+        }
+        v.emplace();
+    }
+    else if(! engaged)
+    {
+        return;
+    }
+    io(ar, *v);
+}
+
+template<class Ar, class T>
+void
+io(Ar& ar, std::vector<T>& v)
+{
+    std::size_t size = v.size();
+    io(ar, size);
+    if constexpr(Ar::reading)
+    {
+        // every element uses at least one byte
+        if(size > ar.remaining())
+            formatError("binary data: invalid size {}", size).Throw();
+        v.clear();
+        v.resize(size);
+    }
+    for(auto& e : v)
+        io(ar, e);
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unordered_map<std::string, std::vector<SymbolID>>& m)
+{
+    std::size_t size = m.size();
+    io(ar, size);
+    if constexpr(Ar::reading)
+    {
+        m.clear();
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            std::string key;
+            io(ar, key);
+            io(ar, m[std::move(key)]);
+        }
+    }
+    else
+    {
+        // the entries are sorted so the
+        // encoding does not depend on the
+        // order of the hash table
+        std::vector<std::string const*> keys;
+        keys.reserve(size);
+        for(auto const& [key, ids] : m)
+            keys.push_back(&key);
+        std::ranges::sort(keys, [](auto a, auto b) { return *a < *b; });
+        for(std::string const* key : keys)
+        {
+            io(ar, const_cast<std::string&>(*key));
+            io(ar, m.find(*key)->second);
+        }
+    }
+}
+
+// Encode a pointer to a polymorphic object.
+// The kind is encoded first, with 0 for null,
+// and the reader uses the kind to create the
+// object before its members are decoded.
+template<class Ar, class T, class Kind, class Make, class Fields>
+void
+ioPolymorphic(
+    Ar& ar,
+    std::unique_ptr<T>& p,
+    Kind kind,
+    Make const& make,
+    Fields const& fields)
+{
+    std::uint64_t k = p ? static_cast<std::uint64_t>(kind) : 0;
+    io(ar, k);
+    if constexpr(Ar::reading)
+    {
+        if(k == 0)
+        {
+            p.reset();
+            return;
+        }
+        p = make(static_cast<Kind>(k));
+        if(! p)
+            formatError("binary data: invalid kind {}", k).Throw();
+    }
+    else if(! p)
+    {
+        return;
+    }
+    fields(*p);
+}
+
+//------------------------------------------------
+
+template<class Ar>
+void
+io(Ar& ar, Location& loc)
+{
+    // the file is encoded by value and
+    // interned again when it is decoded
+    std::string path(loc.path());
+    std::string filename(loc.filename());
+    FileKind kind = loc.kind();
+    io(ar, path);
+    io(ar, filename);
+    io(ar, loc.LineNumber);
+    io(ar, kind);
+    io(ar, loc.Documented);
+    if constexpr(Ar::reading)
+    {
+        loc.File = filename.empty() ? nullptr :
+            &internSourceFile(path, filename, kind);
+    }
+}
+
+template<class Ar>
+void
+io(Ar& ar, OptionalLocation& loc)
+{
+    // empty when the filename is empty
+    io(ar, loc.value());
+}
+
+template<class Ar>
+void
+io(Ar& ar, ExprInfo& E)
+{
+    io(ar, E.Written);
+}
+
+template<class Ar, class T>
+void
+io(Ar& ar, ConstantExprInfo<T>& E)
+{
+    io(ar, static_cast<ExprInfo&>(E));
+    io(ar, E.Value);
+}
+
+template<class Ar>
+void
+io(Ar& ar, NoexceptInfo& I)
+{
+    io(ar, I.Implicit);
+    io(ar, I.Kind);
+    io(ar, I.Operand);
+}
+
+template<class Ar>
+void
+io(Ar& ar, ExplicitInfo& I)
+{
+    io(ar, I.Implicit);
+    io(ar, I.Kind);
+    io(ar, I.Operand);
+}
+
+//------------------------------------------------
+//
+// Names, types, and templates
+//
+//------------------------------------------------
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<NameInfo>& p)
+{
+    ioPolymorphic(ar, p, p ? p->Kind : NameKind(),
+        [](NameKind kind) -> std::unique_ptr<NameInfo>
+        {
+            switch(kind)
+            {
+            case NameKind::Identifier:
+                return std::make_unique<NameInfo>();
+            case NameKind::Specialization:
+                return std::make_unique<SpecializationNameInfo>();
+            default:
+                return nullptr;
+            }
+        },
+        [&](NameInfo& N)
+        {
+            io(ar, N.id);
+            io(ar, N.Name);
+            io(ar, N.Prefix);
+            if(N.isSpecialization())
+                io(ar, static_cast<SpecializationNameInfo&>(N).TemplateArgs);
+        });
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<TypeInfo>& p)
+{
+    ioPolymorphic(ar, p, p ? p->Kind : TypeKind(),
+        [](TypeKind kind) -> std::unique_ptr<TypeInfo>
+        {
+            switch(kind)
+            {
+            case TypeKind::Named:
+                return std::make_unique<NamedTypeInfo>();
+            case TypeKind::Decltype:
+                return std::make_unique<DecltypeTypeInfo>();
+            case TypeKind::Auto:
+                return std::make_unique<AutoTypeInfo>();
+            case TypeKind::LValueReference:
+                return std::make_unique<LValueReferenceTypeInfo>();
+            case TypeKind::RValueReference:
+                return std::make_unique<RValueReferenceTypeInfo>();
+            case TypeKind::Pointer:
+                return std::make_unique<PointerTypeInfo>();
+            case TypeKind::MemberPointer:
+                return std::make_unique<MemberPointerTypeInfo>();
+            case TypeKind::Array:
+                return std::make_unique<ArrayTypeInfo>();
+            case TypeKind::Function:
+                return std::make_unique<FunctionTypeInfo>();
+            default:
+                return nullptr;
+            }
+        },
+        [&](TypeInfo& T)
+        {
+            io(ar, T.IsPackExpansion);
+            visit(T, [&]<class TypeTy>(TypeTy& t)
+            {
+                if constexpr(TypeTy::isNamed())
+                {
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.Name);
+                }
+                if constexpr(TypeTy::isDecltype())
+                {
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.Operand);
+                }
+                if constexpr(TypeTy::isAuto())
+                {
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.Keyword);
+                    io(ar, t.Constraint);
+                }
+                if constexpr(
+                    TypeTy::isLValueReference() ||
+                    TypeTy::isRValueReference())
+                {
+                    io(ar, t.PointeeType);
+                }
+                if constexpr(TypeTy::isPointer())
+                {
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.PointeeType);
+                }
+                if constexpr(TypeTy::isMemberPointer())
+                {
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.ParentType);
+                    io(ar, t.PointeeType);
+                }
+                if constexpr(TypeTy::isArray())
+                {
+                    io(ar, t.ElementType);
+                    io(ar, t.Bounds);
+                }
+                if constexpr(TypeTy::isFunction())
+                {
+                    io(ar, t.ReturnType);
+                    io(ar, t.ParamTypes);
+                    io(ar, t.CVQualifiers);
+                    io(ar, t.RefQualifier);
+                    io(ar, t.ExceptionSpec);
+                    io(ar, t.IsVariadic);
+                }
+            });
+        });
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<TArg>& p)
+{
+    ioPolymorphic(ar, p, p ? p->Kind : TArgKind(),
+        [](TArgKind kind) -> std::unique_ptr<TArg>
+        {
+            switch(kind)
+            {
+            case TArgKind::Type:
+                return std::make_unique<TypeTArg>();
+            case TArgKind::NonType:
+                return std::make_unique<NonTypeTArg>();
+            case TArgKind::Template:
+                return std::make_unique<TemplateTArg>();
+            default:
+                return nullptr;
+            }
+        },
+        [&](TArg& A)
+        {
+            io(ar, A.IsPackExpansion);
+            visit(A, [&]<class ArgTy>(ArgTy& a)
+            {
+                if constexpr(ArgTy::isType())
+                {
+                    io(ar, a.Type);
+                }
+                if constexpr(ArgTy::isNonType())
+                {
+                    io(ar, a.Value);
+                }
+                if constexpr(ArgTy::isTemplate())
+                {
+                    io(ar, a.Template);
+                    io(ar, a.Name);
+                }
+            });
+        });
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<TParam>& p)
+{
+    ioPolymorphic(ar, p, p ? p->Kind : TParamKind(),
+        [](TParamKind kind) -> std::unique_ptr<TParam>
+        {
+            switch(kind)
+            {
+            case TParamKind::Type:
+                return std::make_unique<TypeTParam>();
+            case TParamKind::NonType:
+                return std::make_unique<NonTypeTParam>();
+            case TParamKind::Template:
+                return std::make_unique<TemplateTParam>();
+            default:
+                return nullptr;
+            }
+        },
+        [&](TParam& P)
+        {
+            io(ar, P.Name);
+            io(ar, P.IsParameterPack);
+            io(ar, P.Default);
+            visit(P, [&]<class ParamTy>(ParamTy& t)
+            {
+                if constexpr(ParamTy::isType())
+                {
+                    io(ar, t.KeyKind);
+                    io(ar, t.Constraint);
+                }
+                if constexpr(ParamTy::isNonType())
+                {
+                    io(ar, t.Type);
+                }
+                if constexpr(ParamTy::isTemplate())
+                {
+                    io(ar, t.Params);
+                }
+            });
+        });
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<TemplateInfo>& p)
+{
+    bool engaged = p != nullptr;
+    io(ar, engaged);
+    if constexpr(Ar::reading)
+    {
+        if(! engaged)
+        {
+            p.reset();
+            return;
+        }
+        p = std::make_unique<TemplateInfo>();
+    }
+    else if(! engaged)
+    {
+        return;
+    }
+    io(ar, p->Params);
+    io(ar, p->Args);
+    io(ar, p->Requires);
+    io(ar, p->Primary);
+}
+
+template<class Ar>
+void
+io(Ar& ar, Param& P)
+{
+    io(ar, P.Type);
+    io(ar, P.Name);
+    io(ar, P.Default);
+}
+
+template<class Ar>
+void
+io(Ar& ar, BaseInfo& B)
+{
+    io(ar, B.Type);
+    io(ar, B.Access);
+    io(ar, B.IsVirtual);
+}
+
+//------------------------------------------------
+//
+// Javadoc
+//
+//------------------------------------------------
+
+template<class Ar, class NodeTy>
+requires std::derived_from<NodeTy, doc::Node>
+void
+io(Ar& ar, std::unique_ptr<NodeTy>& p)
+{
+    ioPolymorphic(ar, p, p ? p->kind : doc::Kind(),
+        [](doc::Kind kind) -> std::unique_ptr<NodeTy>
+        {
+            return doc::visit(kind,
+                [&]<class T>() -> std::unique_ptr<NodeTy>
+                {
+                    // a node of the wrong category is
+                    // reported as an invalid kind
+                    if constexpr(std::derived_from<T, NodeTy>)
+                        return std::make_unique<T>();
+                    else
+                        return nullptr;
+                });
+        },
+        [&](doc::Node& node)
+        {
+            doc::visit(node, [&]<class T>(T& N)
+            {
+                if constexpr(std::derived_from<T, doc::Text>)
+                {
+                    io(ar, N.string);
+                }
+                if constexpr(std::same_as<T, doc::Styled>)
+                {
+                    io(ar, N.style);
+                }
+                if constexpr(std::same_as<T, doc::Link>)
+                {
+                    io(ar, N.href);
+                }
+                if constexpr(std::derived_from<T, doc::Reference>)
+                {
+                    io(ar, N.id);
+                }
+                if constexpr(std::same_as<T, doc::Copied>)
+                {
+                    io(ar, N.parts);
+                }
+                if constexpr(std::derived_from<T, doc::Block>)
+                {
+                    io(ar, N.children);
+                }
+                if constexpr(std::same_as<T, doc::Heading>)
+                {
+                    io(ar, N.string);
+                }
+                if constexpr(std::same_as<T, doc::Admonition>)
+                {
+                    io(ar, N.admonish);
+                }
+                if constexpr(std::same_as<T, doc::Param>)
+                {
+                    io(ar, N.name);
+                    io(ar, N.direction);
+                }
+                if constexpr(std::same_as<T, doc::TParam>)
+                {
+                    io(ar, N.name);
+                }
+                if constexpr(std::same_as<T, doc::Throws>)
+                {
+                    io(ar, N.exception);
+                }
+            });
+        });
+}
+
+template<class Ar>
+void
+io(Ar& ar, std::unique_ptr<Javadoc>& p)
+{
+    bool engaged = p != nullptr;
+    io(ar, engaged);
+    if constexpr(Ar::reading)
+    {
+        if(! engaged)
+        {
+            p.reset();
+            return;
+        }
+        p = std::make_unique<Javadoc>();
+    }
+    else if(! engaged)
+    {
+        return;
+    }
+    io(ar, p->getBlocks());
+}
+
+//------------------------------------------------
+//
+// Info
+//
+//------------------------------------------------
+
+template<class Ar>
+void
+ioInfo(Ar& ar, Info& I)
+{
+    io(ar, I.Name);
+    io(ar, I.Access);
+    io(ar, I.Implicit);
+    io(ar, I.Namespace);
+    io(ar, I.javadoc);
+}
+
+template<class Ar>
+void
+ioSource(Ar& ar, SourceInfo& I)
+{
+    io(ar, I.DefLoc);
+    io(ar, I.Loc);
+}
+
+template<class Ar>
+void
+ioScope(Ar& ar, ScopeInfo& I)
+{
+    io(ar, I.Members);
+    io(ar, I.Lookups);
+}
+
+template<class Ar>
+void io(Ar& ar, NamespaceInfo& I)
+{
+    ioScope(ar, I);
+    io(ar, I.IsInline);
+    io(ar, I.IsAnonymous);
+    io(ar, I.UsingDirectives);
+}
+
+template<class Ar>
+void io(Ar& ar, RecordInfo& I)
+{
+    ioSource(ar, I);
+    ioScope(ar, I);
+    io(ar, I.KeyKind);
+    io(ar, I.Template);
+    io(ar, I.IsTypeDef);
+    io(ar, I.IsFinal);
+    io(ar, I.IsFinalDestructor);
+    io(ar, I.Bases);
+}
+
+template<class Ar>
+void io(Ar& ar, FunctionInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.ReturnType);
+    io(ar, I.Params);
+    io(ar, I.Template);
+    io(ar, I.Class);
+    io(ar, I.Noexcept);
+    io(ar, I.Explicit);
+    io(ar, I.Requires);
+    io(ar, I.IsVariadic);
+    io(ar, I.IsVirtual);
+    io(ar, I.IsVirtualAsWritten);
+    io(ar, I.IsPure);
+    io(ar, I.IsDefaulted);
+    io(ar, I.IsExplicitlyDefaulted);
+    io(ar, I.IsDeleted);
+    io(ar, I.IsDeletedAsWritten);
+    io(ar, I.IsNoReturn);
+    io(ar, I.HasOverrideAttr);
+    io(ar, I.HasTrailingReturn);
+    io(ar, I.IsConst);
+    io(ar, I.IsVolatile);
+    io(ar, I.IsFinal);
+    io(ar, I.IsNodiscard);
+    io(ar, I.IsExplicitObjectMemberFunction);
+    io(ar, I.Constexpr);
+    io(ar, I.OverloadedOperator);
+    io(ar, I.StorageClass);
+    io(ar, I.RefQualifier);
+}
+
+template<class Ar>
+void io(Ar& ar, EnumInfo& I)
+{
+    ioSource(ar, I);
+    ioScope(ar, I);
+    io(ar, I.Scoped);
+    io(ar, I.UnderlyingType);
+}
+
+template<class Ar>
+void io(Ar& ar, TypedefInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Type);
+    io(ar, I.IsUsing);
+    io(ar, I.Template);
+}
+
+template<class Ar>
+void io(Ar& ar, VariableInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Type);
+    io(ar, I.Template);
+    io(ar, I.Initializer);
+    io(ar, I.StorageClass);
+    io(ar, I.Constexpr);
+    io(ar, I.IsConstinit);
+    io(ar, I.IsThreadLocal);
+}
+
+template<class Ar>
+void io(Ar& ar, FieldInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Type);
+    io(ar, I.Default);
+    io(ar, I.IsMutable);
+    io(ar, I.IsBitfield);
+    io(ar, I.BitfieldWidth);
+    io(ar, I.IsMaybeUnused);
+    io(ar, I.IsDeprecated);
+    io(ar, I.HasNoUniqueAddress);
+}
+
+template<class Ar>
+void io(Ar& ar, SpecializationInfo& I)
+{
+    ioScope(ar, I);
+    io(ar, I.Args);
+    io(ar, I.Primary);
+}
+
+template<class Ar>
+void io(Ar& ar, FriendInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.FriendSymbol);
+    io(ar, I.FriendType);
+}
+
+template<class Ar>
+void io(Ar& ar, EnumeratorInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Initializer);
+}
+
+template<class Ar>
+void io(Ar& ar, GuideInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Deduced);
+    io(ar, I.Template);
+    io(ar, I.Params);
+    io(ar, I.Explicit);
+}
+
+template<class Ar>
+void io(Ar& ar, AliasInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.AliasedSymbol);
+}
+
+template<class Ar>
+void io(Ar& ar, UsingInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Class);
+    io(ar, I.UsingSymbols);
+    io(ar, I.Qualifier);
+}
+
+template<class Ar>
+void io(Ar& ar, ConceptInfo& I)
+{
+    ioSource(ar, I);
+    io(ar, I.Template);
+    io(ar, I.Constraint);
+}
+
+template<class Ar>
+void
+ioMembers(Ar& ar, Info& I)
+{
+    ioInfo(ar, I);
+    visit(I, [&]<class InfoTy>(InfoTy& II)
+    {
+        io(ar, II);
+    });
+}
+
+std::unique_ptr<Info>
+makeInfo(InfoKind kind, SymbolID const& id)
+{
+    switch(kind)
+    {
+    #define INFO_PASCAL(Type) \
+    case InfoKind::Type: \
+        return std::make_unique<Type##Info>(id);
+    #include <mrdocs/Metadata/InfoNodes.inc>
+    default:
+        return nullptr;
+    }
+}
+
+constexpr char infoSetMagic[4] = { 'M', 'R', 'D', 'I' };
+constexpr char corpusMagic[4] = { 'M', 'R', 'D', 'B' };
+
+// magic, version, string count,
+// string bytes, and Info count
+constexpr std::size_t corpusHeaderSize = 32;
+
+// SymbolID, kind, and offset
+constexpr std::size_t corpusEntrySize = 32;
+
+constexpr
+std::size_t
+align8(std::size_t n) noexcept
+{
+    return (n + 7) & ~std::size_t(7);
+}
+
+void
+put32(std::string& out, std::uint32_t v)
+{
+    char buf[4];
+    llvm::support::endian::write32le(buf, v);
+    out.append(buf, sizeof(buf));
+}
+
+void
+put64(std::string& out, std::uint64_t v)
+{
+    char buf[8];
+    llvm::support::endian::write64le(buf, v);
+    out.append(buf, sizeof(buf));
+}
+
+std::vector<Info const*>
+sortedInfo(InfoSet const& info)
+{
+    std::vector<Info const*> sorted;
+    sorted.reserve(info.size());
+    for(auto const& I : info)
+        sorted.push_back(I.get());
+    std::ranges::sort(sorted, [](Info const* a, Info const* b)
+    {
+        return a->id < b->id;
+    });
+    return sorted;
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+void
+BinaryWriter::
+write(Info const& I)
+{
+    Info& II = const_cast<Info&>(I);
+    io(*this, II.Kind);
+    io(*this, II.id);
+    ioMembers(*this, II);
+}
+
+std::unique_ptr<Info>
+BinaryReader::
+readInfo()
+{
+    InfoKind kind;
+    io(*this, kind);
+    SymbolID id;
+    io(*this, id);
+    std::unique_ptr<Info> I = makeInfo(kind, id);
+    if(! I)
+        formatError("binary data: invalid Info kind {}",
+            static_cast<int>(kind)).Throw();
+    ioMembers(*this, *I);
+    return I;
+}
+
+//------------------------------------------------
+
+std::string
+encodeInfoSet(InfoSet const& info)
+{
+    std::vector<Info const*> const sorted = sortedInfo(info);
+
+    BinaryWriter body;
+    for(Info const* I : sorted)
+        body.write(*I);
+
+    BinaryWriter out;
+    out.bytes(infoSetMagic, sizeof(infoSetMagic));
+    out.varint(binaryFormatVersion);
+    out.varint(body.strings().size());
+    for(std::string_view s : body.strings())
+    {
+        out.varint(s.size());
+        out.bytes(s.data(), s.size());
+    }
+    out.varint(sorted.size());
+    out.bytes(body.data().data(), body.data().size());
+    return out.data();
+}
+
+Expected<InfoSet>
+decodeInfoSet(std::string_view data)
+{
+    try
+    {
+        char magic[sizeof(infoSetMagic)];
+        BinaryReader header(data, {});
+        header.bytes(magic, sizeof(magic));
+        if(std::memcmp(magic, infoSetMagic, sizeof(magic)) != 0)
+            formatError("binary data: invalid header").Throw();
+        if(auto const version = header.varint();
+            version != binaryFormatVersion)
+        {
+            formatError("binary data: version {} is not supported",
+                version).Throw();
+        }
+
+        std::uint64_t const stringCount = header.varint();
+        if(stringCount > header.remaining())
+            formatError("binary data: invalid string table").Throw();
+        std::vector<std::string_view> strings;
+        strings.reserve(stringCount);
+        std::string_view rest = data.substr(data.size() - header.remaining());
+        for(std::uint64_t i = 0; i < stringCount; ++i)
+        {
+            BinaryReader r(rest, {});
+            std::uint64_t const size = r.varint();
+            if(size > r.remaining())
+                formatError("binary data: invalid string table").Throw();
+            rest.remove_prefix(rest.size() - r.remaining());
+            strings.push_back(rest.substr(0, size));
+            rest.remove_prefix(size);
+        }
+
+        BinaryReader r(rest, strings);
+        std::uint64_t const count = r.varint();
+        InfoSet result;
+        result.reserve(count);
+        for(std::uint64_t i = 0; i < count; ++i)
+            result.emplace(r.readInfo());
+        if(! r.done())
+            formatError("binary data: unexpected data after the last Info").Throw();
+        return result;
+    }
+    catch(Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
+}
+
+//------------------------------------------------
+//
+// Corpus
+//
+//------------------------------------------------
+
+std::string
+encodeCorpus(InfoSet const& info)
+{
+    std::vector<Info const*> const sorted = sortedInfo(info);
+
+    BinaryWriter body;
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(sorted.size());
+    for(Info const* I : sorted)
+    {
+        offsets.push_back(body.data().size());
+        body.write(*I);
+    }
+
+    auto const& strings = body.strings();
+    std::uint64_t stringBytes = 0;
+    for(std::string_view str : strings)
+        stringBytes += str.size();
+
+    std::string out;
+    out.reserve(
+        corpusHeaderSize +
+        (strings.size() + 1) * 8 +
+        align8(stringBytes) +
+        sorted.size() * corpusEntrySize +
+        body.data().size());
+
+    out.append(corpusMagic, sizeof(corpusMagic));
+    put32(out, binaryFormatVersion);
+    put64(out, strings.size());
+    put64(out, stringBytes);
+    put64(out, sorted.size());
+
+    std::uint64_t offset = 0;
+    for(std::string_view str : strings)
+    {
+        put64(out, offset);
+        offset += str.size();
+    }
+    put64(out, offset);
+    for(std::string_view str : strings)
+        out.append(str);
+    out.resize(align8(out.size()), '\0');
+
+    for(std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        out.append(
+            reinterpret_cast<char const*>(sorted[i]->id.data()),
+            sorted[i]->id.size());
+        put32(out, static_cast<std::uint32_t>(sorted[i]->Kind));
+        put64(out, offsets[i]);
+    }
+    out.append(body.data());
+    return out;
+}
+
+Expected<CorpusView>
+CorpusView::
+create(std::string_view data)
+{
+    using llvm::support::endian::read32le;
+    using llvm::support::endian::read64le;
+
+    if(data.size() < corpusHeaderSize ||
+        std::memcmp(data.data(), corpusMagic, sizeof(corpusMagic)) != 0)
+        return Unexpected(formatError("corpus: invalid header"));
+    if(auto const version = read32le(data.data() + 4);
+        version != binaryFormatVersion)
+        return Unexpected(formatError(
+            "corpus: version {} is not supported", version));
+    std::uint64_t const stringCount = read64le(data.data() + 8);
+    std::uint64_t const stringBytes = read64le(data.data() + 16);
+    std::uint64_t const infoCount = read64le(data.data() + 24);
+
+    // every size is checked against the
+    // remaining data before it is used
+    std::size_t pos = corpusHeaderSize;
+    auto const take = [&](std::uint64_t n) -> char const*
+    {
+        if(n > data.size() - pos)
+            return nullptr;
+        char const* p = data.data() + pos;
+        pos += n;
+        return p;
+    };
+
+    if(stringCount >= data.size() / 8)
+        return Unexpected(formatError("corpus: invalid string table"));
+    char const* offsets = take((stringCount + 1) * 8);
+    char const* chars = offsets ? take(stringBytes) : nullptr;
+    if(! chars)
+        return Unexpected(formatError("corpus: invalid string table"));
+    pos = std::min(align8(pos), data.size());
+
+    CorpusView view;
+    view.strings_.reserve(stringCount);
+    std::uint64_t prev = 0;
+    for(std::uint64_t i = 1; i <= stringCount; ++i)
+    {
+        std::uint64_t const next = read64le(offsets + i * 8);
+        if(next < prev || next > stringBytes)
+            return Unexpected(formatError("corpus: invalid string table"));
+        view.strings_.emplace_back(chars + prev, next - prev);
+        prev = next;
+    }
+
+    if(infoCount >= data.size() / corpusEntrySize)
+        return Unexpected(formatError("corpus: invalid index"));
+    view.index_ = take(infoCount * corpusEntrySize);
+    if(! view.index_)
+        return Unexpected(formatError("corpus: invalid index"));
+    view.size_ = infoCount;
+    view.infos_ = data.substr(pos);
+
+    prev = 0;
+    for(std::size_t i = 0; i < view.size_; ++i)
+    {
+        std::uint64_t const offset = read64le(
+            view.index_ + i * corpusEntrySize + 24);
+        if(offset < prev || offset > view.infos_.size())
+            return Unexpected(formatError("corpus: invalid index"));
+        prev = offset;
+    }
+    return view;
+}
+
+SymbolID
+CorpusView::
+id(std::size_t i) const noexcept
+{
+    MRDOCS_ASSERT(i < size_);
+    return SymbolID(reinterpret_cast<std::uint8_t const*>(
+        index_ + i * corpusEntrySize));
+}
+
+InfoKind
+CorpusView::
+kind(std::size_t i) const noexcept
+{
+    MRDOCS_ASSERT(i < size_);
+    return static_cast<InfoKind>(llvm::support::endian::read32le(
+        index_ + i * corpusEntrySize + 20));
+}
+
+Expected<std::unique_ptr<Info>>
+CorpusView::
+read(std::size_t i) const
+{
+    MRDOCS_ASSERT(i < size_);
+    using llvm::support::endian::read64le;
+    char const* entry = index_ + i * corpusEntrySize;
+    std::uint64_t const first = read64le(entry + 24);
+    std::uint64_t const last = i + 1 < size_ ?
+        read64le(entry + corpusEntrySize + 24) :
+        infos_.size();
+    try
+    {
+        BinaryReader r(infos_.substr(first, last - first), strings_);
+        std::unique_ptr<Info> I = r.readInfo();
+        if(! r.done() || I->id != id(i) || I->Kind != kind(i))
+            formatError("corpus: Info does not match the index").Throw();
+        return I;
+    }
+    catch(Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
+}
+
+Expected<std::unique_ptr<Info>>
+CorpusView::
+find(SymbolID const& id) const
+{
+    // the index is ordered by SymbolID
+    std::size_t lo = 0;
+    std::size_t hi = size_;
+    while(lo < hi)
+    {
+        std::size_t const mid = lo + (hi - lo) / 2;
+        SymbolID const other = this->id(mid);
+        if(other == id)
+            return read(mid);
+        if(other < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return nullptr;
+}
+
+Expected<InfoSet>
+CorpusView::
+readAll() const
+{
+    InfoSet result;
+    result.reserve(size_);
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        MRDOCS_TRY(std::unique_ptr<Info> I, read(i));
+        result.emplace(std::move(I));
+    }
+    return result;
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,255 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_METADATA_BINARY_HPP
+#define MRDOCS_LIB_METADATA_BINARY_HPP
+
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Metadata/Info.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <llvm/ADT/StringMap.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The version of the binary encoding of Info.
+
+    The version is stored with the encoded data,
+    and data with a different version is rejected.
+    It must be incremented whenever the encoding
+    of any Info, or of any of its members, changes.
+*/
+constexpr std::uint32_t binaryFormatVersion = 1;
+
+/** Encodes Info objects in a compact binary form.
+
+    Integers and enumerations are encoded as
+    variable length integers, and symbol IDs
+    as their 20 bytes. Strings are interned:
+    every distinct string is added once to the
+    string table of the writer, and the encoded
+    Info only refers to its index.
+
+    The encoded Info can be decoded with a
+    @ref BinaryReader that uses the same
+    string table.
+*/
+class BinaryWriter
+{
+    std::string out_;
+    llvm::StringMap<std::uint32_t> index_;
+    std::vector<std::string_view> strings_;
+
+public:
+    static constexpr bool reading = false;
+
+    /** Append the encoding of an Info.
+    */
+    void
+    write(Info const& I);
+
+    /** Return the encoded data.
+    */
+    std::string const&
+    data() const noexcept
+    {
+        return out_;
+    }
+
+    /** Remove the encoded data.
+
+        The string table is kept, so strings
+        already interned are not added again.
+    */
+    void
+    clear() noexcept
+    {
+        out_.clear();
+    }
+
+    /** Return the string table.
+    */
+    std::vector<std::string_view> const&
+    strings() const noexcept
+    {
+        return strings_;
+    }
+
+    void varint(std::uint64_t value);
+    void bytes(void const* data, std::size_t size);
+    void string(std::string_view s);
+};
+
+/** Decodes Info objects encoded by a @ref BinaryWriter.
+
+    Decoding errors throw an @ref Exception.
+*/
+class BinaryReader
+{
+    char const* it_;
+    char const* end_;
+    std::span<std::string_view const> strings_;
+
+public:
+    static constexpr bool reading = true;
+
+    /** Constructor.
+
+        @param data The encoded data.
+        @param strings The string table of the
+        writer that encoded the data.
+    */
+    BinaryReader(
+        std::string_view data,
+        std::span<std::string_view const> strings) noexcept
+        : it_(data.data())
+        , end_(data.data() + data.size())
+        , strings_(strings)
+    {
+    }
+
+    /** Return true if all the data was decoded.
+    */
+    bool
+    done() const noexcept
+    {
+        return it_ == end_;
+    }
+
+    /** Return the number of bytes left to decode.
+    */
+    std::size_t
+    remaining() const noexcept
+    {
+        return end_ - it_;
+    }
+
+    /** Decode the next Info.
+    */
+    std::unique_ptr<Info>
+    readInfo();
+
+    std::uint64_t varint();
+    void bytes(void* data, std::size_t size);
+    std::string_view string();
+};
+
+/** Return a self-contained encoding of a set of Info.
+
+    The encoding has a header with the format
+    version, followed by the string table and the
+    Info objects ordered by SymbolID, so equal sets
+    always have the same encoding.
+*/
+std::string
+encodeInfoSet(InfoSet const& info);
+
+/** Decode a set of Info encoded by @ref encodeInfoSet.
+*/
+Expected<InfoSet>
+decodeInfoSet(std::string_view data);
+
+//------------------------------------------------
+
+/** Return the corpus file encoding of a set of Info.
+
+    The encoding starts with a fixed size header
+    with the format version and the size of each
+    section, followed by:
+
+    @li The string table, as the offsets of every
+    string followed by the characters.
+
+    @li The index, with the SymbolID, the kind, and
+    the offset of every Info, ordered by SymbolID.
+
+    @li The encoded Info objects.
+
+    Offsets and sizes are 64-bit little endian
+    integers aligned to 8 bytes, so a file can be
+    memory mapped and used directly with a
+    @ref CorpusView.
+*/
+std::string
+encodeCorpus(InfoSet const& info);
+
+/** A view of a corpus file.
+
+    The view does not own the data, which must
+    remain valid while the view is used. Info
+    objects are only decoded when requested.
+*/
+class CorpusView
+{
+    std::vector<std::string_view> strings_;
+    char const* index_ = nullptr;
+    std::size_t size_ = 0;
+    std::string_view infos_;
+
+    CorpusView() = default;
+
+public:
+    /** Return a view of encoded corpus data.
+
+        The header and the string table are
+        validated. Errors in the encoded Info
+        objects are reported when they are
+        decoded.
+    */
+    static
+    Expected<CorpusView>
+    create(std::string_view data);
+
+    /** Return the number of Info objects.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the SymbolID of the i-th Info.
+    */
+    SymbolID
+    id(std::size_t i) const noexcept;
+
+    /** Return the kind of the i-th Info.
+    */
+    InfoKind
+    kind(std::size_t i) const noexcept;
+
+    /** Decode the i-th Info.
+    */
+    Expected<std::unique_ptr<Info>>
+    read(std::size_t i) const;
+
+    /** Decode the Info with the specified SymbolID.
+
+        @return The Info, or `nullptr` if the
+        corpus has no Info with this SymbolID.
+    */
+    Expected<std::unique_ptr<Info>>
+    find(SymbolID const& id) const;
+
+    /** Decode every Info.
+    */
+    Expected<InfoSet>
+    readAll() const;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -14,9 +14,15 @@
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Metadata/DomMetadata.hpp>
 #include <llvm/ADT/StringMap.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -139,10 +145,10 @@ dom::Object
 domCreate(Location const& loc)
 {
     return dom::Object({
-        { "path",       loc.Path },
-        { "file",       loc.Filename },
+        { "path",       loc.path() },
+        { "file",       loc.filename() },
         { "line",       loc.LineNumber },
-        { "kind",       toString(loc.Kind) },
+        { "kind",       toString(loc.kind()) },
         { "documented", loc.Documented }
         });
 }
@@ -922,12 +928,100 @@ DomInfo<T>::construct() const
 
 class DomCorpus::Impl
 {
-    using value_type = std::weak_ptr<dom::ObjectImpl>;
+    using Policy = PublicSettings::DomCachePolicy;
+
+    // Approximate memory used by a symbol object,
+    // used to turn the memory budget of the LRU
+    // policy into a number of objects.
+    static constexpr std::size_t approxObjectSize = 2048;
+
+    // The shard of a symbol is chosen by the last
+    // byte of its SymbolID, which is a hash. The
+    // leading bytes are used by the hash of the maps.
+    static constexpr std::size_t shardCount = 64;
+
+    struct Entry
+    {
+        // weak policy
+        std::weak_ptr<dom::ObjectImpl> weak;
+
+        // strong and lru policies
+        std::shared_ptr<dom::ObjectImpl> strong;
+
+        // Set when the object is used, and cleared
+        // when the clock hand of the lru policy
+        // passes over the entry.
+        std::atomic<bool> referenced = true;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<SymbolID, Entry> map;
+
+        // The cached symbols in the order visited
+        // by the clock hand of the lru policy
+        std::vector<SymbolID> clock;
+        std::size_t hand = 0;
+
+        std::atomic<std::size_t> hits = 0;
+        std::atomic<std::size_t> misses = 0;
+    };
 
     DomCorpus const& domCorpus_;
     Corpus const& corpus_;
-    std::unordered_map<SymbolID, value_type> cache_;
-    std::mutex mutex_;
+    Policy policy_;
+    std::size_t shardCapacity_;
+    std::array<Shard, shardCount> shards_;
+
+    std::shared_ptr<dom::ObjectImpl>
+    lookup(Entry& entry) const
+    {
+        if(policy_ == Policy::Weak)
+            return entry.weak.lock();
+        entry.referenced.store(true, std::memory_order_relaxed);
+        return entry.strong;
+    }
+
+    void
+    store(
+        Entry& entry,
+        std::shared_ptr<dom::ObjectImpl> const& impl) const
+    {
+        if(policy_ == Policy::Weak)
+            entry.weak = impl;
+        else
+            entry.strong = impl;
+    }
+
+    // Add a new entry to the clock of the lru policy,
+    // evicting the first entry that was not used since
+    // the clock hand last passed over it when the
+    // shard is full.
+    void
+    insertClock(
+        Shard& shard,
+        SymbolID const& id)
+    {
+        if(shard.clock.size() < shardCapacity_)
+        {
+            shard.clock.push_back(id);
+            return;
+        }
+        for(;;)
+        {
+            SymbolID& victim = shard.clock[shard.hand];
+            shard.hand = (shard.hand + 1) % shard.clock.size();
+            auto it = shard.map.find(victim);
+            MRDOCS_ASSERT(it != shard.map.end());
+            if(it->second.referenced.exchange(
+                false, std::memory_order_relaxed))
+                continue;
+            shard.map.erase(it);
+            victim = id;
+            return;
+        }
+    }
 
 public:
     Impl(
@@ -935,7 +1029,25 @@ public:
         Corpus const& corpus)
         : domCorpus_(domCorpus)
         , corpus_(corpus)
+        , policy_(corpus.config->domCache)
+        , shardCapacity_(std::max<std::size_t>(1,
+            std::size_t(corpus.config->domCacheBudget) *
+                1024 * 1024 / approxObjectSize / shardCount))
+    {
+    }
+
+    ~Impl()
     {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        for(Shard const& shard : shards_)
+        {
+            hits += shard.hits.load(std::memory_order_relaxed);
+            misses += shard.misses.load(std::memory_order_relaxed);
+        }
+        report::debug(
+            "DOM cache ({}): {} hits, {} misses",
+            to_string(policy_), hits, misses);
     }
 
     Corpus const&
@@ -959,19 +1071,38 @@ public:
         if(! I)
             return {}; // VFALCO Hack
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(id);
-        if(it == cache_.end())
+        // the leading bytes are used by std::hash<SymbolID>
+        Shard& shard = shards_[id.data()[id.size() - 1] % shardCount];
         {
-            auto obj = create(*I);
-            cache_.insert(
-                { id, obj.impl() });
-            return obj;
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.map.find(id);
+            if(it != shard.map.end())
+            {
+                if(auto sp = lookup(it->second))
+                {
+                    shard.hits.fetch_add(1, std::memory_order_relaxed);
+                    return dom::Object(std::move(sp));
+                }
+            }
         }
-        if(auto sp = it->second.lock())
-            return dom::Object(sp);
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+        // The object is created without holding the
+        // lock, so other threads are not blocked
         auto obj = create(*I);
-        it->second = obj.impl();
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto [it, inserted] = shard.map.try_emplace(id);
+        if(! inserted)
+        {
+            // Another thread created the object first
+            if(auto sp = lookup(it->second))
+                return dom::Object(std::move(sp));
+        }
+        else if(policy_ == Policy::Lru)
+        {
+            insertClock(shard, id);
+        }
+        store(it->second, obj.impl());
         return obj;
     }
 };
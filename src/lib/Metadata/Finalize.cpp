@@ -12,6 +12,7 @@
 #include "lib/Lib/Info.hpp"
 #include "lib/Support/NameParser.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 #include <algorithm>
 #include <ranges>
 #include <span>
@@ -25,11 +26,15 @@ namespace mrdocs {
     which do not exist.
 
     References which should always be valid are not checked.
+
+    A finalizer only modifies the Info it is currently
+    visiting, so several finalizers may visit disjoint
+    subsets of the same InfoSet concurrently.
 */
 class Finalizer
 {
-    InfoSet& info_;
-    SymbolLookup& lookup_;
+    const InfoSet& info_;
+    const SymbolLookup& lookup_;
     Info* current_ = nullptr;
 
     bool resolveReference(doc::Reference& ref)
@@ -54,7 +59,7 @@ class Finalizer
         const Info* found = nullptr;
         if(parse_result->qualified)
         {
-            Info* context = current_;
+            const Info* context = current_;
             std::vector<std::string_view> qualifier;
             // KRYSTIAN FIXME: lookupQualified should accept
             // std::vector<std::string> as the qualifier
@@ -263,8 +268,8 @@ class Finalizer
 
 public:
     Finalizer(
-        InfoSet& Info,
-        SymbolLookup& Lookup)
+        const InfoSet& Info,
+        const SymbolLookup& Lookup)
         : info_(Info)
         , lookup_(Lookup)
     {
@@ -396,16 +401,51 @@ public:
     which do not exist.
 
     References which should always be valid are not checked.
+
+    The symbols are partitioned into contiguous
+    chunks which are finalized on the thread pool.
 */
-void
-finalize(InfoSet& Info, SymbolLookup& Lookup)
+std::vector<Error>
+finalize(
+    InfoSet& info,
+    const SymbolLookup& lookup,
+    ThreadPool& threadPool)
 {
-    Finalizer visitor(Info, Lookup);
-    for(auto& I : Info)
+    std::vector<Info*> infos;
+    infos.reserve(info.size());
+    for(auto& I : info)
     {
         MRDOCS_ASSERT(I);
-        visitor.finalize(*I);
+        infos.push_back(I.get());
+    }
+
+    if(threadPool.getThreadCount() <= 1)
+    {
+        Finalizer visitor(info, lookup);
+        for(Info* I : infos)
+            visitor.finalize(*I);
+        return {};
+    }
+
+    // use several chunks per thread so that threads which
+    // finish early can pick up the remaining work
+    std::size_t const size = infos.size();
+    std::size_t const chunks = std::min<std::size_t>(
+        size, threadPool.getThreadCount() * 8);
+    TaskGroup taskGroup(threadPool);
+    for(std::size_t i = 0; i < chunks; ++i)
+    {
+        std::span<Info* const> chunk(
+            infos.data() + size * i / chunks,
+            infos.data() + size * (i + 1) / chunks);
+        taskGroup.async([&info, &lookup, chunk]
+        {
+            Finalizer visitor(info, lookup);
+            for(Info* I : chunk)
+                visitor.finalize(*I);
+        });
     }
+    return taskGroup.wait();
 }
 
 } // mrdocs
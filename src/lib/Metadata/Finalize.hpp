@@ -13,11 +13,25 @@
 
 #include "lib/Lib/Info.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
 
-void finalize(InfoSet& Info, SymbolLookup& Lookup);
+class ThreadPool;
+
+/** Finalizes a set of Info.
+
+    @return Zero or more errors which were
+    thrown while finalizing the symbols.
+*/
+[[nodiscard]]
+std::vector<Error>
+finalize(
+    InfoSet& info,
+    const SymbolLookup& lookup,
+    ThreadPool& threadPool);
 
 } // mrdocs
 } // clang
@@ -13,6 +13,8 @@
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Platform.hpp>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+#include <cstdint>
 
 namespace clang {
 namespace mrdocs {
@@ -27,8 +29,8 @@ struct LocationEqual
         Location const& L1) const noexcept
     {
         return
-            std::tie(L0.LineNumber, L0.Filename) ==
-            std::tie(L1.LineNumber, L1.Filename);
+            L0.LineNumber == L1.LineNumber &&
+            L0.filename() == L1.filename();
     }
 };
 
@@ -43,8 +45,8 @@ struct LocationLess
         Location const& L1) const noexcept
     {
         return
-            std::tie(L0.LineNumber, L0.Filename) <
-            std::tie(L1.LineNumber, L1.Filename);
+            std::make_tuple(L0.LineNumber, L0.filename()) <
+            std::make_tuple(L1.LineNumber, L1.filename());
     }
 };
 
@@ -53,12 +55,51 @@ reduceSymbolIDs(
     std::vector<SymbolID>& list,
     std::vector<SymbolID>&& otherList)
 {
+    // searching is cheaper than hashing for short lists,
+    // such as the IDs of most lookups
+    if(list.size() * otherList.size() <= 1024)
+    {
+        for(auto const& id : otherList)
+        {
+            auto it = llvm::find(list, id);
+            if(it != list.end())
+                continue;
+            list.push_back(id);
+        }
+        return;
+    }
+    // large scopes are reported by many translation units,
+    // so merging them must be linear. the IDs are indexed
+    // in an open-addressed table of positions in the list
+    constexpr std::uint32_t empty = ~std::uint32_t(0);
+    std::size_t const capacity =
+        llvm::PowerOf2Ceil(2 * (list.size() + otherList.size()));
+    std::size_t const mask = capacity - 1;
+    std::vector<std::uint32_t> slots(capacity, empty);
+    // returns false if the ID at the index is a duplicate
+    auto insert = [&](std::uint32_t index)
+    {
+        SymbolID const& id = list[index];
+        for(std::size_t i = std::hash<SymbolID>()(id) & mask;;
+            i = (i + 1) & mask)
+        {
+            if(slots[i] == empty)
+            {
+                slots[i] = index;
+                return true;
+            }
+            if(list[slots[i]] == id)
+                return false;
+        }
+    };
+    for(std::uint32_t index = 0; index < list.size(); ++index)
+        insert(index);
+    list.reserve(list.size() + otherList.size());
     for(auto const& id : otherList)
     {
-        auto it = llvm::find(list, id);
-        if(it != list.end())
-            continue;
         list.push_back(id);
+        if(! insert(static_cast<std::uint32_t>(list.size() - 1)))
+            list.pop_back();
     }
 }
 
@@ -10,6 +10,9 @@
 //
 
 #include <mrdocs/Metadata/Source.hpp>
+#include <llvm/ADT/StringMap.h>
+#include <deque>
+#include <mutex>
 
 namespace clang {
 namespace mrdocs {
@@ -30,5 +33,32 @@ toString(FileKind kind)
     };
 }
 
+SourceFile const&
+internSourceFile(
+    std::string_view filepath,
+    std::string_view filename,
+    FileKind kind)
+{
+    static std::mutex mutex;
+    static std::deque<SourceFile> files;
+    static llvm::StringMap<SourceFile const*> index;
+
+    // the kind and short name of a file depend on the
+    // include directories of the translation unit
+    std::string key;
+    key.reserve(filepath.size() + filename.size() + 2);
+    key.append(filepath).push_back('\0');
+    key.append(filename).push_back(static_cast<char>(kind));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, created] = index.try_emplace(key, nullptr);
+    if(created)
+    {
+        it->second = &files.emplace_back(SourceFile{
+            std::string(filepath), std::string(filename), kind});
+    }
+    return *it->second;
+}
+
 } // mrdocs
 } // clang
@@ -0,0 +1,84 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/AddonBundle.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <filesystem>
+
+namespace clang {
+namespace mrdocs {
+
+AddonBundle::
+AddonBundle(
+    std::string_view addons,
+    std::string_view generator)
+    : layouts_(files::appendPath(
+        addons, "generator", generator, "layouts"))
+{
+    namespace fs = std::filesystem;
+
+    // load partials
+    std::string partialsPath = files::appendPath(
+        addons, "generator", generator, "partials");
+    forEachFile(partialsPath, true,
+        [&](std::string_view pathName) -> Expected<void>
+        {
+            fs::path path = pathName;
+            if(path.extension() != ".hbs")
+                return {};
+            path = path.lexically_relative(partialsPath);
+            while(path.has_extension())
+                path.replace_extension();
+
+            MRDOCS_TRY(auto text, files::getFileText(pathName));
+            partials_.emplace_back(
+                path.generic_string(),
+                Handlebars::compile(text));
+            return {};
+        }).maybeThrow();
+
+    // Compile JavaScript helpers
+    std::string helpersPath = files::appendPath(
+        addons, "generator", generator, "helpers");
+    forEachFile(helpersPath, true,
+        [&](std::string_view pathName) -> Expected<void>
+        {
+            constexpr std::string_view ext = ".js";
+            if (!pathName.ends_with(ext)) return {};
+            auto name = files::getFileName(pathName);
+            name.remove_suffix(ext.size());
+            MRDOCS_TRY(auto script, files::getFileText(pathName));
+            auto bytecode = js::compileHelper(script);
+            if (!bytecode)
+            {
+                return Unexpected(formatError(
+                    "helper \"{}\": {}", name, bytecode.error().message()));
+            }
+            helpers_.emplace_back(name, std::move(*bytecode));
+            return {};
+        }).maybeThrow();
+}
+
+Expected<void>
+AddonBundle::
+install(
+    Handlebars& hbs,
+    js::Context& ctx) const
+{
+    for(auto const& [name, tmpl] : partials_)
+        hbs.registerPartial(name, tmpl);
+    for(auto const& [name, bytecode] : helpers_)
+    {
+        MRDOCS_TRY(js::registerCompiledHelper(
+            hbs, name, ctx, bytecode));
+    }
+    return {};
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,98 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_ADDONBUNDLE_HPP
+#define MRDOCS_LIB_SUPPORT_ADDONBUNDLE_HPP
+
+#include "lib/Support/TemplateCache.hpp"
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Handlebars.hpp>
+#include <mrdocs/Support/JavaScript.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The addon files of a generator, loaded once.
+
+    Upon construction, the partials, helpers, and
+    layouts of a generator are read from the addons
+    directory. Partials and layouts are compiled,
+    and JavaScript helpers are compiled to bytecode.
+
+    The bundle is immutable after construction,
+    so a single instance can be shared by all the
+    agents of a generator. Each agent installs the
+    bundle into its own @ref Handlebars environment
+    and JavaScript context, which only loads the
+    bytecode of the helpers and shares the compiled
+    partials.
+*/
+class AddonBundle
+{
+    std::vector<std::pair<std::string, HandlebarsTemplate>> partials_;
+    std::vector<std::pair<std::string, std::string>> helpers_;
+    TemplateCache layouts_;
+
+public:
+    /** Constructor.
+
+        @param addons The addons directory.
+        @param generator The name of the generator
+        directory, such as "html" or "asciidoc".
+    */
+    AddonBundle(
+        std::string_view addons,
+        std::string_view generator);
+
+    /** Return the layouts of the generator.
+    */
+    TemplateCache const&
+    layouts() const noexcept
+    {
+        return layouts_;
+    }
+
+    /** Return the number of partials.
+    */
+    std::size_t
+    partialCount() const noexcept
+    {
+        return partials_.size();
+    }
+
+    /** Return the number of JavaScript helpers.
+    */
+    std::size_t
+    helperCount() const noexcept
+    {
+        return helpers_.size();
+    }
+
+    /** Register the partials and helpers.
+
+        @param hbs The environment where the
+        partials and helpers are registered.
+        @param ctx The JavaScript context where
+        the helpers are loaded. It must outlive
+        the environment.
+    */
+    Expected<void>
+    install(
+        Handlebars& hbs,
+        js::Context& ctx) const;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -9,6 +9,7 @@
 //
 
 #include "Glob.hpp"
+#include <algorithm>
 
 namespace clang {
 namespace mrdocs {
@@ -48,5 +49,198 @@ globMatch(
     return false;
 }
 
+//------------------------------------------------
+
+namespace detail {
+
+void
+CharTrie::
+insert(std::string_view str, std::uint32_t value)
+{
+    std::uint32_t node = 0;
+    for (char c : str)
+    {
+        std::uint32_t next = child(node, c);
+        if (!next)
+        {
+            next = static_cast<std::uint32_t>(nodes_.size());
+            nodes_[node].children.emplace_back(c, next);
+            nodes_.emplace_back();
+        }
+        node = next;
+    }
+    nodes_[node].values.push_back(value);
+}
+
+std::uint32_t
+CharTrie::
+child(std::uint32_t node, char c) const noexcept
+{
+    // the root is never a child, so 0 means none
+    for (auto const& [ch, index] : nodes_[node].children)
+    {
+        if (ch == c)
+        {
+            return index;
+        }
+    }
+    return 0;
+}
+
+} // detail
+
+//------------------------------------------------
+
+namespace {
+
+// match a segment of literal characters and '?'
+bool
+matchSegment(
+    std::string_view segment,
+    std::string_view str) noexcept
+{
+    return std::ranges::equal(segment, str,
+        [](char p, char c)
+        {
+            return p == '?' || p == c;
+        });
+}
+
+// find the first occurrence of a segment
+std::size_t
+findSegment(
+    std::string_view segment,
+    std::string_view str) noexcept
+{
+    if (segment.find('?') == std::string_view::npos)
+    {
+        return str.find(segment);
+    }
+    for (std::size_t i = 0; i + segment.size() <= str.size(); ++i)
+    {
+        if (matchSegment(segment, str.substr(i, segment.size())))
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+} // (anon)
+
+GlobPattern::
+GlobPattern(std::string_view pattern)
+{
+    for (;;)
+    {
+        std::size_t const star = pattern.find('*');
+        segments_.emplace_back(pattern.substr(0, star));
+        if (star == std::string_view::npos)
+        {
+            break;
+        }
+        pattern.remove_prefix(star + 1);
+    }
+}
+
+std::string_view
+GlobPattern::
+prefix() const noexcept
+{
+    std::string_view const first = segments_.front();
+    return first.substr(0, first.find('?'));
+}
+
+bool
+GlobPattern::
+match(std::string_view str) const noexcept
+{
+    std::string_view const first = segments_.front();
+    if (segments_.size() == 1)
+    {
+        return first.size() == str.size() &&
+            matchSegment(first, str);
+    }
+    std::string_view const last = segments_.back();
+    if (str.size() < first.size() + last.size() ||
+        !matchSegment(first, str.substr(0, first.size())) ||
+        !matchSegment(last, str.substr(str.size() - last.size())))
+    {
+        return false;
+    }
+    // the segments between stars match at their
+    // first occurrence, since a later one can only
+    // leave less of the string for the rest
+    str = str.substr(first.size(), str.size() - first.size() - last.size());
+    for (std::size_t i = 1; i + 1 < segments_.size(); ++i)
+    {
+        std::string_view const segment = segments_[i];
+        std::size_t const pos = findSegment(segment, str);
+        if (pos == std::string_view::npos)
+        {
+            return false;
+        }
+        str.remove_prefix(pos + segment.size());
+    }
+    return true;
+}
+
+GlobSet::
+GlobSet(std::span<std::string const> patterns)
+{
+    patterns_.reserve(patterns.size());
+    for (std::string const& pattern : patterns)
+    {
+        auto const index = static_cast<std::uint32_t>(patterns_.size());
+        index_.insert(patterns_.emplace_back(pattern).prefix(), index);
+    }
+}
+
+bool
+GlobSet::
+match(std::string_view str) const noexcept
+{
+    return index_.forEachPrefix(str,
+        [&](std::uint32_t i)
+        {
+            return patterns_[i].match(str);
+        });
+}
+
+namespace {
+
+char
+normalizeSeparator(char c) noexcept
+{
+    return c == '\\' ? '/' : c;
+}
+
+} // (anon)
+
+PrefixSet::
+PrefixSet(std::span<std::string const> prefixes)
+    : size_(prefixes.size())
+{
+    for (std::string const& prefix : prefixes)
+    {
+        std::string normalized(prefix);
+        std::ranges::transform(normalized,
+            normalized.begin(), normalizeSeparator);
+        index_.insert(normalized, 0);
+    }
+}
+
+bool
+PrefixSet::
+match(std::string_view path) const noexcept
+{
+    return index_.forEachPrefix(path,
+        [](std::uint32_t)
+        {
+            return true;
+        },
+        normalizeSeparator);
+}
+
 } // mrdocs
 } // clang
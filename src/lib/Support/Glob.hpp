@@ -11,7 +11,13 @@
 #ifndef MRDOCS_LIB_SUPPORT_GLOB_HPP
 #define MRDOCS_LIB_SUPPORT_GLOB_HPP
 
+#include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -22,6 +28,224 @@ globMatch(
     std::string_view pattern,
     std::string_view str) noexcept;
 
+namespace detail {
+
+/** A trie of strings, mapping each to a set of values.
+*/
+class CharTrie
+{
+    struct Node
+    {
+        std::vector<std::pair<char, std::uint32_t>> children;
+        std::vector<std::uint32_t> values;
+    };
+
+    std::vector<Node> nodes_;
+
+public:
+    /** Constructor.
+    */
+    CharTrie()
+        : nodes_(1)
+    {
+    }
+
+    /** Add a value for a string.
+    */
+    void
+    insert(std::string_view str, std::uint32_t value);
+
+    /** Call a function with the values of each prefix of a string.
+
+        The prefixes are visited from the shortest to the
+        longest, and the visit stops when the function
+        returns true.
+
+        @param str The string.
+        @param f The function.
+        @param proj The projection applied to each
+        character of the string.
+        @return true if the function returned true.
+    */
+    template<class F, class Proj = std::identity>
+    bool
+    forEachPrefix(
+        std::string_view str,
+        F&& f,
+        Proj proj = {}) const
+    {
+        std::uint32_t node = 0;
+        for (std::size_t i = 0;; ++i)
+        {
+            for (std::uint32_t value : nodes_[node].values)
+            {
+                if (f(value))
+                {
+                    return true;
+                }
+            }
+            if (i == str.size())
+            {
+                return false;
+            }
+            node = child(node, proj(str[i]));
+            if (!node)
+            {
+                return false;
+            }
+        }
+    }
+
+private:
+    std::uint32_t
+    child(std::uint32_t node, char c) const noexcept;
+};
+
+} // detail
+
+/** A glob pattern compiled for matching.
+
+    The pattern is split at each `*` into literal
+    segments, which may contain `?`. The first and
+    last segments are matched in place and the others
+    are found from left to right, so matching never
+    backtracks over the stars.
+*/
+class GlobPattern
+{
+    std::vector<std::string> segments_;
+
+public:
+    /** Constructor.
+    */
+    explicit
+    GlobPattern(std::string_view pattern);
+
+    /** Return the literal characters before the first wildcard.
+    */
+    std::string_view
+    prefix() const noexcept;
+
+    /** Check if a string matches the pattern.
+    */
+    bool
+    match(std::string_view str) const noexcept;
+};
+
+/** A set of glob patterns compiled for matching.
+
+    The patterns are indexed by their literal prefix,
+    so only the patterns whose prefix matches are
+    checked against a string.
+*/
+class GlobSet
+{
+    std::vector<GlobPattern> patterns_;
+    detail::CharTrie index_;
+
+public:
+    /** Constructor.
+    */
+    GlobSet() = default;
+
+    /** Constructor.
+    */
+    explicit
+    GlobSet(std::span<std::string const> patterns);
+
+    /** Return true if the set has no patterns.
+    */
+    bool
+    empty() const noexcept
+    {
+        return patterns_.empty();
+    }
+
+    /** Check if a string matches any of the patterns.
+    */
+    bool
+    match(std::string_view str) const noexcept;
+};
+
+/** A set of path prefixes compiled for matching.
+
+    Backslashes and forward slashes are equivalent,
+    as in @ref files::startsWith.
+*/
+class PrefixSet
+{
+    std::size_t size_ = 0;
+    detail::CharTrie index_;
+
+public:
+    /** Constructor.
+    */
+    PrefixSet() = default;
+
+    /** Constructor.
+    */
+    explicit
+    PrefixSet(std::span<std::string const> prefixes);
+
+    /** Return true if the set has no prefixes.
+    */
+    bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /** Check if a path starts with any of the prefixes.
+    */
+    bool
+    match(std::string_view path) const noexcept;
+};
+
+/** The input include prefixes and file patterns.
+
+    A file is an input when it starts with one of the
+    prefixes and matches one of the patterns. An empty
+    list of prefixes or patterns matches every file.
+*/
+class InputFilter
+{
+    PrefixSet include_;
+    GlobSet filePatterns_;
+
+public:
+    /** Constructor.
+    */
+    InputFilter() = default;
+
+    /** Constructor.
+    */
+    InputFilter(
+        std::span<std::string const> include,
+        std::span<std::string const> filePatterns)
+        : include_(include)
+        , filePatterns_(filePatterns)
+    {
+    }
+
+    /** Return true if every file matches.
+    */
+    bool
+    empty() const noexcept
+    {
+        return include_.empty() && filePatterns_.empty();
+    }
+
+    /** Check if a file is an input.
+    */
+    bool
+    match(std::string_view path) const noexcept
+    {
+        return
+            (include_.empty() || include_.match(path)) &&
+            (filePatterns_.empty() || filePatterns_.match(path));
+    }
+};
+
 } // mrdocs
 } // clang
 
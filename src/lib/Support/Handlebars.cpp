@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <chrono>
 #include <algorithm>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 
@@ -400,6 +401,7 @@ namespace detail {
         std::vector<dom::Value> parentContext;
         dom::Value rootContext;
         std::vector<dom::Object> dataStack;
+        CompiledTemplate const* compiled = nullptr;
     };
 }
 
@@ -1384,6 +1386,182 @@ parseTag(
     return t;
 }
 
+// ==============================================================
+// Compiled templates
+// ==============================================================
+
+namespace detail {
+    struct CompiledTemplate
+    {
+        // The template text owned by the compiled template.
+        // All views in the tags and blocks below refer to it.
+        std::string text;
+
+        // The result of findTag when scanning the text from scanBegin.
+        //
+        // The entries form the sequence of tags found by scanning
+        // the text from the beginning, where each scan starts where
+        // the previous tag ends. The last entry represents the
+        // scan that finds no more tags and its buffer is empty.
+        struct TagEntry
+        {
+            // Offset where the scan for this tag begins
+            std::size_t scanBegin = 0;
+
+            // Offset of the first "{{" after scanBegin, or npos
+            std::size_t open = std::string_view::npos;
+
+            // The tag string found by findTag
+            std::string_view buffer;
+
+            // The tag parsed by parseTag with the whole text as context
+            Handlebars::Tag tag;
+        };
+        std::vector<TagEntry> tags;
+
+        // The result of parseBlock when the block content
+        // starts at offset begin of the text
+        struct BlockEntry
+        {
+            // Offset where the block content begins
+            std::size_t begin = 0;
+
+            // Offset where the block content ends when the
+            // block is not closed
+            std::size_t end = 0;
+
+            // The tag that opens the block
+            char const* tag = nullptr;
+
+            // The name of the block
+            std::string_view blockName;
+
+            // Whether the block was parsed with ignoreStandalone
+            bool ignoreStandalone = false;
+
+            // Whether the block has a closing tag
+            bool closed = false;
+
+            // Offset where the template continues after the block
+            std::size_t rest = 0;
+
+            std::string_view fnBlock;
+            std::string_view inverseBlocks;
+            Handlebars::Tag inverseTag;
+            Handlebars::Tag closeTag;
+        };
+        std::vector<BlockEntry> blocks;
+
+        // Get the offset of a view into the template text
+        std::optional<std::size_t>
+        offsetOf(std::string_view sv) const noexcept
+        {
+            auto const b = reinterpret_cast<std::uintptr_t>(text.data());
+            auto const p = reinterpret_cast<std::uintptr_t>(sv.data());
+            if (p < b || p + sv.size() > b + text.size())
+            {
+                return std::nullopt;
+            }
+            return p - b;
+        }
+
+        // Check if a view is the complete template text
+        bool
+        isText(std::string_view sv) const noexcept
+        {
+            return sv.data() == text.data() && sv.size() == text.size();
+        }
+    };
+}
+
+std::string_view
+HandlebarsTemplate::
+text() const noexcept
+{
+    if (!impl_)
+    {
+        return {};
+    }
+    return impl_->text;
+}
+
+// Find the next handlebars tag with the tags of a compiled template
+//
+// The tags of the compiled template are only reused when the
+// result is guaranteed to be the same as scanning the text,
+// i.e.: the scan begins at the same "{{" and the tag is
+// contained in the template text being rendered.
+bool
+findTag(
+    std::string_view &tag,
+    std::string_view templateText,
+    detail::CompiledTemplate const* compiled)
+{
+    if (!compiled)
+    {
+        return findTag(tag, templateText);
+    }
+    auto const begin = compiled->offsetOf(templateText);
+    if (!begin)
+    {
+        return findTag(tag, templateText);
+    }
+    auto it = std::ranges::upper_bound(
+        compiled->tags, *begin, std::less<>{},
+        &detail::CompiledTemplate::TagEntry::scanBegin);
+    if (it == compiled->tags.begin())
+    {
+        return findTag(tag, templateText);
+    }
+    --it;
+    // The escape characters before "{{" must also be in the text
+    bool const sameScan =
+        it->scanBegin == *begin ||
+        it->open == std::string_view::npos ||
+        it->open >= *begin + 2;
+    if (!sameScan)
+    {
+        return findTag(tag, templateText);
+    }
+    if (it->buffer.empty())
+    {
+        return false;
+    }
+    std::size_t const tagEnd =
+        it->buffer.data() + it->buffer.size() - compiled->text.data();
+    if (tagEnd > *begin + templateText.size())
+    {
+        return findTag(tag, templateText);
+    }
+    tag = it->buffer;
+    return true;
+}
+
+// Parse a tag with the tags of a compiled template
+Handlebars::Tag
+parseTag(
+    std::string_view tagStr,
+    std::string_view context,
+    detail::CompiledTemplate const* compiled)
+{
+    if (compiled && compiled->isText(context))
+    {
+        auto it = std::ranges::lower_bound(
+            compiled->tags, tagStr.data(), std::less<>{},
+            [](detail::CompiledTemplate::TagEntry const& e)
+            {
+                return e.tag.buffer.data();
+            });
+        if (it != compiled->tags.end() &&
+            it->tag.buffer.data() == tagStr.data() &&
+            it->tag.buffer.size() == tagStr.size())
+        {
+            return it->tag;
+        }
+    }
+    return parseTag(tagStr, context);
+}
+
 Expected<void, HandlebarsError>
 Handlebars::
 try_render_to(
@@ -1404,6 +1582,27 @@ try_render_to(
     return try_render_to_impl(out, context, options, state);
 }
 
+Expected<void, HandlebarsError>
+Handlebars::
+try_render_to(
+    OutputRef& out,
+    HandlebarsTemplate const& tmpl,
+    dom::Value const& context,
+    HandlebarsOptions const& options) const
+{
+    detail::RenderState state;
+    state.templateText0 = tmpl.text();
+    state.templateText = tmpl.text();
+    state.compiled = tmpl.impl_.get();
+    if (options.data.isObject()) {
+        state.data = options.data.getObject();
+    }
+    state.inlinePartials.emplace_back();
+    state.rootContext = context;
+    state.dataStack.emplace_back(state.data);
+    return try_render_to_impl(out, context, options, state);
+}
+
 Expected<void, HandlebarsError>
 Handlebars::
 try_render_to_impl(
@@ -1417,7 +1616,7 @@ try_render_to_impl(
         // Find next tag
         // ==============================================================
         std::string_view tagStr;
-        if (!findTag(tagStr, state.templateText))
+        if (!findTag(tagStr, state.templateText, state.compiled))
         {
             out << state.templateText;
             break;
@@ -1427,7 +1626,7 @@ try_render_to_impl(
             tagStr.remove_prefix(2);
         }
         std::size_t tagStartPos = tagStr.data() - state.templateText.data();
-        Tag tag = parseTag(tagStr, state.templateText0);
+        Tag tag = parseTag(tagStr, state.templateText0, state.compiled);
 
         // ==============================================================
         // Render template text before tag
@@ -2010,9 +2209,11 @@ auto
 Handlebars::
 getPartial(
     std::string_view name,
-    detail::RenderState const& state) const
+    detail::RenderState const& state,
+    detail::CompiledTemplate const*& compiled) const
     -> std::pair<std::string_view, bool>
 {
+    compiled = nullptr;
     // Inline partials
     auto blockPartials = std::ranges::views::reverse(state.inlinePartials);
     for (auto blockInlinePartials: blockPartials)
@@ -2028,7 +2229,8 @@ getPartial(
     auto it = this->partials_.find(name);
     if (it != this->partials_.end())
     {
-        return {it->second, true};
+        compiled = it->second.impl_.get();
+        return {it->second.text(), true};
     }
 
     // Partial block
@@ -2042,18 +2244,22 @@ getPartial(
     return { {}, false };
 }
 
-// Parse a block starting at templateText
+// Find the block contents starting at templateText
+//
+// When the function returns, templateText is the text
+// after the closing tag of the block.
 Expected<void, HandlebarsError>
-parseBlock(
+parseBlockContent(
     std::string_view blockName,
     Handlebars::Tag const& tag,
     HandlebarsOptions const& opt,
     detail::RenderState const& state,
     std::string_view &templateText,
-    OutputRef &out,
     std::string_view &fnBlock,
     std::string_view &inverseBlocks,
     Handlebars::Tag &inverseTag,
+    Handlebars::Tag &closeTag,
+    bool &closed,
     bool isChainedBlock)
 {
     // ==============================================================
@@ -2077,22 +2283,21 @@ parseBlock(
     // ==============================================================
     // Iterate over the template to find tags and blocks
     // ==============================================================
-    Handlebars::Tag closeTag;
     int l = 1;
     std::string_view* curBlock = &fnBlock;
-    bool closed = false;
+    closed = false;
     while (!templateText.empty())
     {
         // ==============================================================
         // Find next tag
         // ==============================================================
         std::string_view tagStr;
-        if (!findTag(tagStr, templateText))
+        if (!findTag(tagStr, templateText, state.compiled))
         {
             break;
         }
 
-        Handlebars::Tag curTag = parseTag(tagStr, state.templateText0);
+        Handlebars::Tag curTag = parseTag(tagStr, state.templateText0, state.compiled);
 
         // move template after the tag
         auto tag_pos = curTag.buffer.data() - templateText.data();
@@ -2215,6 +2420,94 @@ parseBlock(
         }
         return Unexpected(HandlebarsError(msg));
     }
+    return {};
+}
+
+// Find the block parsed when the template was compiled
+//
+// The block is only reused when the result is guaranteed to
+// be the same as parsing the block in the template text, i.e.:
+// the closing tag is contained in the template text or the
+// text is the same text used to parse the unclosed block.
+detail::CompiledTemplate::BlockEntry const*
+findCompiledBlock(
+    std::string_view blockName,
+    Handlebars::Tag const& tag,
+    HandlebarsOptions const& opt,
+    detail::RenderState const& state,
+    std::string_view templateText,
+    bool isChainedBlock)
+{
+    detail::CompiledTemplate const* compiled = state.compiled;
+    if (!compiled || !compiled->isText(state.templateText0))
+    {
+        return nullptr;
+    }
+    auto const begin = compiled->offsetOf(templateText);
+    if (!begin)
+    {
+        return nullptr;
+    }
+    std::size_t const end = *begin + templateText.size();
+    auto blocks = std::ranges::equal_range(
+        compiled->blocks, *begin, std::less<>{},
+        &detail::CompiledTemplate::BlockEntry::begin);
+    for (auto const& block: blocks)
+    {
+        if (block.tag != tag.buffer.data() ||
+            block.ignoreStandalone != opt.ignoreStandalone ||
+            block.blockName != blockName)
+        {
+            continue;
+        }
+        if (block.closed && block.rest <= end)
+        {
+            return &block;
+        }
+        if (!block.closed && isChainedBlock && block.end == end)
+        {
+            return &block;
+        }
+    }
+    return nullptr;
+}
+
+// Parse a block starting at templateText
+Expected<void, HandlebarsError>
+parseBlock(
+    std::string_view blockName,
+    Handlebars::Tag const& tag,
+    HandlebarsOptions const& opt,
+    detail::RenderState const& state,
+    std::string_view &templateText,
+    OutputRef &out,
+    std::string_view &fnBlock,
+    std::string_view &inverseBlocks,
+    Handlebars::Tag &inverseTag,
+    bool isChainedBlock)
+{
+    Handlebars::Tag closeTag;
+    auto const* block = findCompiledBlock(
+        blockName, tag, opt, state, templateText, isChainedBlock);
+    if (block)
+    {
+        fnBlock = block->fnBlock;
+        inverseBlocks = block->inverseBlocks;
+        inverseTag = block->inverseTag;
+        closeTag = block->closeTag;
+        templateText.remove_prefix(block->rest - block->begin);
+        if (closeTag.removeRWhitespace) {
+            templateText = trim_lspaces(templateText);
+        }
+    }
+    else
+    {
+        bool closed = false;
+        MRDOCS_TRY(parseBlockContent(
+            blockName, tag, opt, state, templateText,
+            fnBlock, inverseBlocks, inverseTag, closeTag,
+            closed, isChainedBlock));
+    }
 
     // ==============================================================
     // Apply close tag whitespace control
@@ -2658,7 +2951,8 @@ renderPartial(
     // ==============================================================
     // Find registered partial content
     // ==============================================================
-    auto [partial_content, found] = getPartial(partialName, state);
+    detail::CompiledTemplate const* partial_compiled = nullptr;
+    auto [partial_content, found] = getPartial(partialName, state, partial_compiled);
     if (!found)
     {
         if (tag.type2 == '#')
@@ -2826,6 +3120,11 @@ renderPartial(
     state.templateText0 = partial_content;
     std::string_view templateText = state.templateText;
     state.templateText = partial_content;
+    detail::CompiledTemplate const* compiled = state.compiled;
+    if (partial_compiled)
+    {
+        state.compiled = partial_compiled;
+    }
     bool const isPartialBlock = partialName == "@partial-block";
     state.partialBlockLevel -= isPartialBlock;
     out.setIndent(out.getIndent() + tag.standaloneIndent * !opt.preventIndent);
@@ -2852,6 +3151,7 @@ renderPartial(
     state.partialBlockLevel += isPartialBlock;
     state.templateText = templateText;
     state.templateText0 = templateText0;
+    state.compiled = compiled;
     if (opt.trackIds && partialCtxChanged)
     {
         state.data.set("contextPath", prevContextPath);
@@ -3336,6 +3636,136 @@ renderBlock(
     return {};
 }
 
+HandlebarsTemplate
+Handlebars::
+compile(std::string_view templateText)
+{
+    using TagEntry = detail::CompiledTemplate::TagEntry;
+    using BlockEntry = detail::CompiledTemplate::BlockEntry;
+
+    auto compiled = std::make_shared<detail::CompiledTemplate>();
+    compiled->text = templateText;
+    std::string_view const text = compiled->text;
+
+    // ==============================================================
+    // Find and parse all tags
+    // ==============================================================
+    std::size_t scanBegin = 0;
+    while (true)
+    {
+        std::string_view const rest = text.substr(scanBegin);
+        TagEntry entry;
+        entry.scanBegin = scanBegin;
+        if (auto open = rest.find("{{"); open != std::string_view::npos)
+        {
+            entry.open = scanBegin + open;
+        }
+        std::string_view tagStr;
+        if (!findTag(tagStr, rest))
+        {
+            entry.buffer = text.substr(text.size());
+            entry.tag.buffer = entry.buffer;
+            compiled->tags.push_back(entry);
+            break;
+        }
+        entry.buffer = tagStr;
+        if (tagStr.starts_with("\\\\"))
+        {
+            tagStr.remove_prefix(2);
+        }
+        entry.tag = parseTag(tagStr, text);
+        compiled->tags.push_back(entry);
+        scanBegin = tagStr.data() + tagStr.size() - text.data();
+    }
+
+    // ==============================================================
+    // Parse all blocks
+    // ==============================================================
+    detail::RenderState state;
+    state.templateText0 = text;
+    state.compiled = compiled.get();
+    auto const offsetOf = [text](std::string_view sv)
+    {
+        return static_cast<std::size_t>(sv.data() - text.data());
+    };
+    for (bool ignoreStandalone: {false, true})
+    {
+        HandlebarsOptions opt;
+        opt.ignoreStandalone = ignoreStandalone;
+        for (TagEntry const& entry: compiled->tags)
+        {
+            Handlebars::Tag const& tag = entry.tag;
+            std::string_view templateText =
+                text.substr(offsetOf(tag.buffer) + tag.buffer.size());
+            if (tag.escaped)
+            {
+                continue;
+            }
+            if (tag.type == '#' || tag.type == '^')
+            {
+                // renderBlock applies the whitespace control
+                // before parsing the block
+                if (tag.removeRWhitespace)
+                {
+                    templateText = trim_lspaces(templateText);
+                }
+            }
+            else if (tag.type2 != '#' || (tag.type != '>' && tag.type != '*'))
+            {
+                continue;
+            }
+
+            // Parse the block and the chained inverse blocks
+            // that will be parsed when the block is rendered
+            std::string_view blockName = tag.helper;
+            Handlebars::Tag blockTag = tag;
+            bool isChainedBlock = false;
+            while (true)
+            {
+                BlockEntry block;
+                block.begin = offsetOf(templateText);
+                block.end = block.begin + templateText.size();
+                block.tag = blockTag.buffer.data();
+                block.blockName = blockName;
+                block.ignoreStandalone = ignoreStandalone;
+                if (!parseBlockContent(
+                        blockName, blockTag, opt, state, templateText,
+                        block.fnBlock, block.inverseBlocks, block.inverseTag,
+                        block.closeTag, block.closed, isChainedBlock))
+                {
+                    break;
+                }
+                block.rest = block.closed ?
+                    offsetOf(block.closeTag.buffer) + block.closeTag.buffer.size() :
+                    offsetOf(templateText);
+                compiled->blocks.push_back(block);
+
+                bool const isChainedInverse =
+                    !block.inverseTag.helper.empty() &&
+                    !block.inverseTag.rawBlock &&
+                    !tag.rawBlock &&
+                    tag.type != '>' && tag.type != '*';
+                if (!isChainedInverse)
+                {
+                    break;
+                }
+                blockTag = block.inverseTag;
+                templateText = block.inverseBlocks;
+                if (blockTag.removeRWhitespace)
+                {
+                    templateText = trim_lspaces(templateText);
+                }
+                isChainedBlock = true;
+            }
+        }
+    }
+    std::ranges::stable_sort(compiled->blocks, std::less<>{}, &BlockEntry::begin);
+
+    HandlebarsTemplate tmpl;
+    tmpl.impl_ = std::move(compiled);
+    return tmpl;
+}
+
 void
 Handlebars::
 registerPartial(
@@ -3345,7 +3775,19 @@ registerPartial(
     auto it = partials_.find(name);
     if (it != partials_.end())
         partials_.erase(it);
-    partials_.emplace(std::string(name), std::string(text));
+    partials_.emplace(std::string(name), compile(text));
+}
+
+void
+Handlebars::
+registerPartial(
+    std::string_view name,
+    HandlebarsTemplate tmpl)
+{
+    auto it = partials_.find(name);
+    if (it != partials_.end())
+        partials_.erase(it);
+    partials_.emplace(std::string(name), std::move(tmpl));
 }
 
 void
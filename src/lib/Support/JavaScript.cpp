@@ -14,6 +14,7 @@
 #include <mrdocs/Support/JavaScript.hpp>
 #include <mrdocs/Support/Handlebars.hpp>
 #include <duktape.h>
+#include <cstring>
 #include <utility>
 #include <variant>
 #include <llvm/Support/raw_ostream.h>
@@ -294,6 +295,43 @@ compile_function(
     return Access::construct<Value>(-1, *this);
 }
 
+Expected<std::string>
+Scope::
+dump_function(
+    Value const& fn)
+{
+    Access A(*this);
+    if (!fn.isFunction() ||
+        duk_is_c_function(A, Access::idx(fn)) ||
+        duk_is_bound_function(A, Access::idx(fn)))
+    {
+        return Unexpected(formatError("value is not a compiled function"));
+    }
+    duk_dup(A, Access::idx(fn));
+    duk_dump_function(A);
+    duk_size_t size = 0;
+    void const* data = duk_get_buffer(A, -1, &size);
+    std::string bytecode(static_cast<char const*>(data), size);
+    duk_pop(A);
+    return bytecode;
+}
+
+Expected<Value>
+Scope::
+load_function(
+    std::string_view bytecode)
+{
+    Access A(*this);
+    if (bytecode.empty())
+    {
+        return Unexpected(formatError("empty function bytecode"));
+    }
+    void* buf = duk_push_fixed_buffer(A, bytecode.size());
+    std::memcpy(buf, bytecode.data(), bytecode.size());
+    duk_load_function(A);
+    return Access::construct<Value>(-1, *this);
+}
+
 Value
 Scope::
 getGlobalObject()
@@ -1880,41 +1918,48 @@ operator&&(Value const& lhs, Value const& rhs)
     return rhs;
 }
 
+namespace {
+
+constexpr auto global_helpers_key = DUK_HIDDEN_SYMBOL("MrDocsHelpers");
+
+// Store a JS helper function in the hidden helpers
+// object of the global scope
 Expected<void, Error>
-registerHelper(
-    clang::mrdocs::Handlebars& hbs,
+setGlobalHelper(
+    Scope& s,
     std::string_view name,
-    Context& ctx,
-    std::string_view script)
+    Value const& JSFn)
 {
-    // Register the compiled helper function in the global scope
-    constexpr auto global_helpers_key = DUK_HIDDEN_SYMBOL("MrDocsHelpers");
+    Value g = s.getGlobalObject();
+    MRDOCS_ASSERT(g.isObject());
+    if (!g.exists(global_helpers_key))
     {
-        Scope s(ctx);
-        Value g = s.getGlobalObject();
-        MRDOCS_ASSERT(g.isObject());
-        if (!g.exists(global_helpers_key))
-        {
-            Value obj = s.pushObject();
-            MRDOCS_ASSERT(obj.isObject());
-            g.set(global_helpers_key, obj);
-        }
-        Value helpers = g.get(global_helpers_key);
-        MRDOCS_ASSERT(helpers.isObject());
-        MRDOCS_TRY(Value JSFn, s.compile_function(script));
-        if (!JSFn.isFunction())
-        {
-            return Unexpected(Error(fmt::format(
-                    "helper \"{}\" is not a function", name)));
-        }
-        helpers.set(name, JSFn);
+        Value obj = s.pushObject();
+        MRDOCS_ASSERT(obj.isObject());
+        g.set(global_helpers_key, obj);
     }
+    Value helpers = g.get(global_helpers_key);
+    MRDOCS_ASSERT(helpers.isObject());
+    if (!JSFn.isFunction())
+    {
+        return Unexpected(Error(fmt::format(
+                "helper \"{}\" is not a function", name)));
+    }
+    helpers.set(name, JSFn);
+    return {};
+}
 
-    // Register C++ helper that retrieves the helper
-    // from the global object, converts the arguments,
-    // and invokes the JS function.
+// Register C++ helper that retrieves the JS helper
+// from the global object, converts the arguments,
+// and invokes the JS function.
+void
+registerGlobalHelper(
+    clang::mrdocs::Handlebars& hbs,
+    std::string_view name,
+    Context& ctx)
+{
     hbs.registerHelper(name, dom::makeVariadicInvocable(
-        [&ctx, global_helpers_key, name=std::string(name)](
+        [&ctx, name=std::string(name)](
             dom::Array const& args) -> Expected<dom::Value>
         {
             // Get function from global scope
@@ -1981,6 +2026,53 @@ registerHelper(
             }
             return result;
         }));
+}
+
+} // (anon)
+
+Expected<void, Error>
+registerHelper(
+    clang::mrdocs::Handlebars& hbs,
+    std::string_view name,
+    Context& ctx,
+    std::string_view script)
+{
+    // Register the compiled helper function in the global scope
+    {
+        Scope s(ctx);
+        MRDOCS_TRY(Value JSFn, s.compile_function(script));
+        MRDOCS_TRY(setGlobalHelper(s, name, JSFn));
+    }
+    registerGlobalHelper(hbs, name, ctx);
+    return {};
+}
+
+Expected<std::string, Error>
+compileHelper(std::string_view script)
+{
+    Context ctx;
+    Scope s(ctx);
+    MRDOCS_TRY(Value JSFn, s.compile_function(script));
+    if (!JSFn.isFunction())
+    {
+        return Unexpected(Error("helper is not a function"));
+    }
+    return s.dump_function(JSFn);
+}
+
+Expected<void, Error>
+registerCompiledHelper(
+    clang::mrdocs::Handlebars& hbs,
+    std::string_view name,
+    Context& ctx,
+    std::string_view bytecode)
+{
+    {
+        Scope s(ctx);
+        MRDOCS_TRY(Value JSFn, s.load_function(bytecode));
+        MRDOCS_TRY(setGlobalHelper(s, name, JSFn));
+    }
+    registerGlobalHelper(hbs, name, ctx);
     return {};
 }
 
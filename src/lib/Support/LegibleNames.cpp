@@ -345,6 +345,12 @@ public:
             });
     }
 
+    bool
+    contains(const SymbolID& id) const noexcept
+    {
+        return map_.contains(id);
+    }
+
     void
     getLegibleUnqualified(
         std::string& result,
@@ -406,6 +412,14 @@ LegibleNames(
 LegibleNames::
 ~LegibleNames() noexcept = default;
 
+bool
+LegibleNames::
+contains(
+    SymbolID const& id) const noexcept
+{
+    return ! impl_ || impl_->contains(id);
+}
+
 std::string
 LegibleNames::
 getUnqualified(
@@ -46,6 +46,16 @@ public:
 
     ~LegibleNames() noexcept;
 
+    /** Return true if the symbol has a legible name.
+
+        Only the symbols reachable from the global
+        namespace are named. When legible names are
+        disabled, every symbol has a name.
+    */
+    bool
+    contains(
+        SymbolID const& id) const noexcept;
+
     std::string
     getUnqualified(
         SymbolID const& id) const;
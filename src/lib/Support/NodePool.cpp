@@ -0,0 +1,216 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Support/NodePool.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// the pool hides use-after-free from the address sanitizer
+#if defined(__SANITIZE_ADDRESS__)
+#define MRDOCS_NODE_POOL 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MRDOCS_NODE_POOL 0
+#endif
+#endif
+#ifndef MRDOCS_NODE_POOL
+#define MRDOCS_NODE_POOL 1
+#endif
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// sizes are rounded up to a multiple of the
+// alignment guaranteed by the global operator new
+constexpr std::size_t granularity = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr std::size_t maxNodeSize = 512;
+constexpr std::size_t sizeClasses = maxNodeSize / granularity;
+constexpr std::size_t blockSize = 64 * 1024;
+
+struct FreeNode
+{
+    FreeNode* next;
+};
+
+// A list of free nodes of one size class
+struct Batch
+{
+    FreeNode* head = nullptr;
+    std::size_t count = 0;
+};
+
+// The nodes and the unused parts of blocks which
+// threads give back, so that other threads can
+// reuse them. A thread gives back its free nodes
+// when it holds two blocks of them, and everything
+// it holds when it exits.
+struct Depot
+{
+    std::mutex mutex;
+    std::array<std::vector<Batch>, sizeClasses> batches;
+    std::vector<std::pair<char*, char*>> spans;
+};
+
+// never destroyed, since nodes of static
+// objects can be freed during exit
+Depot&
+depot()
+{
+    static Depot* const d = new Depot;
+    return *d;
+}
+
+// set when the pool of the thread is destroyed, for
+// the nodes of objects destroyed after it
+thread_local bool poolDestroyed = false;
+
+class LocalPool
+{
+    std::array<Batch, sizeClasses> free_{};
+    char* pos_ = nullptr;
+    char* end_ = nullptr;
+
+    void
+    refill(std::size_t index)
+    {
+        std::size_t const size = (index + 1) * granularity;
+        {
+            Depot& d = depot();
+            std::lock_guard<std::mutex> lock(d.mutex);
+            auto& batches = d.batches[index];
+            if(! batches.empty())
+            {
+                free_[index] = batches.back();
+                batches.pop_back();
+                return;
+            }
+            // the rest of the block is too small for
+            // this node, but may hold smaller ones
+            if(end_ - pos_ >= static_cast<std::ptrdiff_t>(granularity))
+                d.spans.emplace_back(pos_, end_);
+            pos_ = end_ = nullptr;
+            auto it = std::ranges::find_if(d.spans,
+                [size](auto const& span)
+                {
+                    return static_cast<std::size_t>(
+                        span.second - span.first) >= size;
+                });
+            if(it != d.spans.end())
+            {
+                std::tie(pos_, end_) = *it;
+                *it = d.spans.back();
+                d.spans.pop_back();
+                return;
+            }
+        }
+        pos_ = static_cast<char*>(::operator new(blockSize));
+        end_ = pos_ + blockSize;
+    }
+
+public:
+    ~LocalPool()
+    {
+        poolDestroyed = true;
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex);
+        for(std::size_t i = 0; i < sizeClasses; ++i)
+        {
+            if(free_[i].head)
+                d.batches[i].push_back(free_[i]);
+        }
+        if(end_ - pos_ >= static_cast<std::ptrdiff_t>(granularity))
+            d.spans.emplace_back(pos_, end_);
+    }
+
+    void*
+    allocate(std::size_t index)
+    {
+        std::size_t const size = (index + 1) * granularity;
+        if(! free_[index].head &&
+            static_cast<std::size_t>(end_ - pos_) < size)
+            refill(index);
+        if(FreeNode* node = free_[index].head)
+        {
+            free_[index].head = node->next;
+            --free_[index].count;
+            return node;
+        }
+        void* p = pos_;
+        pos_ += size;
+        return p;
+    }
+
+    void
+    deallocate(void* p, std::size_t index) noexcept
+    {
+        Batch& list = free_[index];
+        auto* node = static_cast<FreeNode*>(p);
+        node->next = list.head;
+        list.head = node;
+        ++list.count;
+        // nodes freed by a thread which did not
+        // allocate them are given back in batches
+        std::size_t const size = (index + 1) * granularity;
+        if(list.count * size < 2 * blockSize)
+            return;
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex);
+        d.batches[index].push_back(list);
+        list = {};
+    }
+};
+
+thread_local LocalPool pool;
+
+constexpr
+std::size_t
+sizeClass(std::size_t size) noexcept
+{
+    return (size + granularity - 1) / granularity - 1;
+}
+
+} // (anon)
+
+void*
+allocateNode(std::size_t size)
+{
+    if(! MRDOCS_NODE_POOL || size == 0 || size > maxNodeSize)
+        return ::operator new(size);
+    if(poolDestroyed)
+        return ::operator new(
+            (sizeClass(size) + 1) * granularity);
+    return pool.allocate(sizeClass(size));
+}
+
+void
+deallocateNode(void* p, std::size_t size) noexcept
+{
+    if(! MRDOCS_NODE_POOL || size == 0 || size > maxNodeSize)
+        return ::operator delete(p, size);
+    if(poolDestroyed)
+    {
+        auto* node = static_cast<FreeNode*>(p);
+        node->next = nullptr;
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex);
+        d.batches[sizeClass(size)].push_back({ node, 1 });
+        return;
+    }
+    pool.deallocate(p, sizeClass(size));
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,108 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/TemplateCache.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <filesystem>
+#include <mutex>
+
+namespace clang {
+namespace mrdocs {
+
+TemplateCache::
+TemplateCache(
+    std::string_view dir,
+    bool watch)
+    : dir_(dir)
+    , watch_(watch)
+{
+    namespace fs = std::filesystem;
+
+    // A missing directory is reported when
+    // a template is requested
+    if(! files::isDirectory(dir_))
+        return;
+
+    forEachFile(dir_, true,
+        [&](std::string_view pathName) -> Expected<void>
+        {
+            fs::path path = pathName;
+            if(path.extension() != ".hbs")
+                return {};
+            std::string name =
+                path.lexically_relative(dir_).generic_string();
+            MRDOCS_TRY(auto entry, load(name));
+            templates_.emplace(std::move(name), std::move(entry));
+            return {};
+        }).maybeThrow();
+}
+
+auto
+TemplateCache::
+load(std::string_view name) const ->
+    Expected<Entry>
+{
+    std::string pathName = files::appendPath(dir_, name);
+    Entry entry;
+    if(watch_)
+    {
+        llvm::sys::fs::file_status status;
+        if(auto ec = llvm::sys::fs::status(pathName, status))
+            return Unexpected(Error(ec));
+        entry.mtime = status.getLastModificationTime();
+    }
+    MRDOCS_TRY(auto text, files::getFileText(pathName));
+    entry.tmpl = Handlebars::compile(text);
+    return entry;
+}
+
+Expected<HandlebarsTemplate>
+TemplateCache::
+get(std::string_view name) const
+{
+    if(! watch_)
+    {
+        // The loaded templates are never
+        // modified, only new ones are added
+        {
+            std::shared_lock<std::shared_mutex> read_lock(mutex_);
+            auto it = templates_.find(name);
+            if(it != templates_.end())
+                return it->second.tmpl;
+        }
+        MRDOCS_TRY(auto entry, load(name));
+        std::unique_lock<std::shared_mutex> write_lock(mutex_);
+        // Another thread may have loaded
+        // the template in the meantime
+        return templates_.try_emplace(
+            std::string(name), std::move(entry)).first->second.tmpl;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> read_lock(mutex_);
+        auto it = templates_.find(name);
+        if(it != templates_.end())
+        {
+            llvm::sys::fs::file_status status;
+            std::string pathName = files::appendPath(dir_, name);
+            if(! llvm::sys::fs::status(pathName, status) &&
+                status.getLastModificationTime() == it->second.mtime)
+                return it->second.tmpl;
+        }
+    }
+
+    MRDOCS_TRY(auto entry, load(name));
+    HandlebarsTemplate tmpl = entry.tmpl;
+    std::unique_lock<std::shared_mutex> write_lock(mutex_);
+    templates_.insert_or_assign(std::string(name), std::move(entry));
+    return tmpl;
+}
+
+} // mrdocs
+} // clang
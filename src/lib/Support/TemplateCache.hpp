@@ -0,0 +1,87 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_TEMPLATECACHE_HPP
+#define MRDOCS_LIB_SUPPORT_TEMPLATECACHE_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Handlebars.hpp>
+#include <llvm/Support/Chrono.h>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace clang {
+namespace mrdocs {
+
+/** A cache of compiled Handlebars templates.
+
+    Upon construction, every template in a
+    directory is read and compiled once, so
+    that the templates can be rendered any
+    number of times without reading the files
+    again.
+
+    The cache is safe to use from multiple
+    threads, so a single instance can be shared
+    by all the agents of a generator.
+
+    When files are watched, the modification
+    time of a template is checked every time the
+    template is requested, and the template is
+    loaded again when the file has changed. This
+    is intended for long-running processes where
+    the templates can be edited between renders.
+*/
+class TemplateCache
+{
+    struct Entry
+    {
+        HandlebarsTemplate tmpl;
+        llvm::sys::TimePoint<> mtime;
+    };
+
+    using map_type = std::unordered_map<
+        std::string, Entry,
+        detail::string_hash, std::equal_to<>>;
+
+    std::string dir_;
+    bool watch_;
+    mutable std::shared_mutex mutex_;
+    mutable map_type templates_;
+
+    Expected<Entry>
+    load(std::string_view name) const;
+
+public:
+    /** Constructor.
+
+        @param dir The directory with the templates.
+        @param watch If true, templates are loaded
+        again when their files are modified.
+    */
+    explicit
+    TemplateCache(
+        std::string_view dir,
+        bool watch = false);
+
+    /** Return the compiled template with the given name.
+
+        @param name The path of the template file,
+        relative to the directory of the cache.
+    */
+    Expected<HandlebarsTemplate>
+    get(std::string_view name) const;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,145 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Trace.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+#include <atomic>
+#include <mutex>
+
+namespace clang {
+namespace mrdocs {
+namespace trace {
+
+namespace {
+
+struct Event
+{
+    std::string name;
+    std::string category;
+    clock_type::time_point start;
+    clock_type::time_point end;
+    std::uint64_t tid;
+    std::vector<std::pair<std::string, Value>> args;
+};
+
+std::atomic<bool> enabled_ = false;
+clock_type::time_point epoch_;
+std::mutex mutex_;
+std::vector<Event> events_;
+
+std::int64_t
+toMicroseconds(clock_type::duration d) noexcept
+{
+    return std::chrono::duration_cast<
+        std::chrono::microseconds>(d).count();
+}
+
+} // (anon)
+
+void
+enable()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_)
+    {
+        epoch_ = clock_type::now();
+        enabled_ = true;
+    }
+}
+
+bool
+enabled() noexcept
+{
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+void
+record(
+    std::string_view name,
+    std::string_view category,
+    clock_type::time_point start,
+    clock_type::time_point end,
+    std::vector<std::pair<std::string, Value>> args)
+{
+    if (!enabled())
+    {
+        return;
+    }
+    Event event{
+        std::string(name),
+        std::string(category),
+        start,
+        end,
+        llvm::get_threadid(),
+        std::move(args)};
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(event));
+}
+
+Expected<void>
+write(std::string_view path)
+{
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+    if (ec)
+    {
+        return Unexpected(formatError(
+            "Failed to open \"{}\": {}", path, ec));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    llvm::json::OStream J(os);
+    J.object([&]
+    {
+        J.attributeArray("traceEvents", [&]
+        {
+            for (Event const& event : events_)
+            {
+                J.object([&]
+                {
+                    J.attribute("name", event.name);
+                    J.attribute("cat", event.category);
+                    J.attribute("ph", "X");
+                    J.attribute("pid", 1);
+                    J.attribute("tid", static_cast<std::int64_t>(event.tid));
+                    J.attribute("ts", toMicroseconds(event.start - epoch_));
+                    J.attribute("dur", toMicroseconds(event.end - event.start));
+                    if (event.args.empty())
+                    {
+                        return;
+                    }
+                    J.attributeObject("args", [&]
+                    {
+                        for (auto const& [key, value] : event.args)
+                        {
+                            std::visit([&](auto const& v)
+                            {
+                                J.attribute(key, v);
+                            }, value);
+                        }
+                    });
+                });
+            }
+        });
+        J.attribute("displayTimeUnit", "ms");
+    });
+    os.close();
+    if (os.has_error())
+    {
+        os.clear_error();
+        return Unexpected(formatError("Failed to write \"{}\"", path));
+    }
+    return {};
+}
+
+} // trace
+} // mrdocs
+} // clang
@@ -0,0 +1,172 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_TRACE_HPP
+#define MRDOCS_LIB_SUPPORT_TRACE_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace trace {
+
+/** Instrumentation of the phases of a build.
+
+    When enabled, spans of time are recorded as
+    they complete, from any thread, and written
+    in the Chrome trace event format, which can
+    be viewed in `chrome://tracing` or Perfetto.
+
+    Recording is disabled by default, and a
+    disabled span costs a single check.
+*/
+
+using clock_type = std::chrono::steady_clock;
+
+/** The value of an argument of a span.
+*/
+using Value = std::variant<std::int64_t, double, std::string>;
+
+/** Start recording spans.
+*/
+MRDOCS_DECL
+void
+enable();
+
+/** Return true if spans are recorded.
+*/
+MRDOCS_DECL
+bool
+enabled() noexcept;
+
+/** Record a span which completed.
+
+    @param name The name of the span.
+    @param category The category of the span.
+    @param start The time the span started.
+    @param end The time the span ended.
+    @param args The arguments of the span.
+*/
+MRDOCS_DECL
+void
+record(
+    std::string_view name,
+    std::string_view category,
+    clock_type::time_point start,
+    clock_type::time_point end,
+    std::vector<std::pair<std::string, Value>> args = {});
+
+/** Write the recorded spans to a file.
+
+    The spans are written in the Chrome
+    trace event format.
+
+    @param path The path of the file.
+*/
+MRDOCS_DECL
+Expected<void>
+write(std::string_view path);
+
+/** A span of time recorded when it ends.
+
+    The span ends when it is destroyed,
+    or when @ref end is called.
+*/
+class Span
+{
+    std::string_view name_;
+    std::string_view category_;
+    clock_type::time_point start_;
+    std::vector<std::pair<std::string, Value>> args_;
+    bool active_;
+
+public:
+    /** Constructor.
+
+        @param name The name of the span, which must
+        outlive it.
+        @param category The category of the span, which
+        must outlive it.
+    */
+    explicit
+    Span(
+        std::string_view name,
+        std::string_view category = "mrdocs")
+        : name_(name)
+        , category_(category)
+        , active_(enabled())
+    {
+        if (active_)
+        {
+            start_ = clock_type::now();
+        }
+    }
+
+    Span(Span const&) = delete;
+    Span& operator=(Span const&) = delete;
+
+    ~Span()
+    {
+        end();
+    }
+
+    /** Return true if the span is recorded.
+    */
+    bool
+    active() const noexcept
+    {
+        return active_;
+    }
+
+    /** Add an argument to the span.
+    */
+    void
+    arg(std::string_view key, Value value)
+    {
+        if (active_)
+        {
+            args_.emplace_back(std::string(key), std::move(value));
+        }
+    }
+
+    /** End the span.
+    */
+    void
+    end()
+    {
+        if (active_)
+        {
+            active_ = false;
+            record(name_, category_, start_,
+                clock_type::now(), std::move(args_));
+        }
+    }
+};
+
+/** Return a duration in milliseconds, as a span argument.
+*/
+template<class Rep, class Period>
+double
+toMilliseconds(std::chrono::duration<Rep, Period> d) noexcept
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // trace
+} // mrdocs
+} // clang
+
+#endif
@@ -1286,6 +1286,20 @@ struct JavaScript_test
             js::registerHelper(hbs, "opt", ctx, "function(options) { return options.hash.a; }");
             BOOST_TEST(hbs.render("{{opt a=1}}") == "1");
         }
+
+        // Helpers compiled once and loaded into several contexts
+        {
+            auto bytecode = js::compileHelper(
+                "function(a, b) { return a * b; }");
+            BOOST_TEST(bytecode.has_value());
+            Handlebars hbs2;
+            js::Context ctx2;
+            BOOST_TEST(js::registerCompiledHelper(hbs, "mul", ctx, *bytecode));
+            BOOST_TEST(js::registerCompiledHelper(hbs2, "mul", ctx2, *bytecode));
+            BOOST_TEST(hbs.render("{{mul 2 3}}") == "6");
+            BOOST_TEST(hbs2.render("{{mul 4 5}}") == "20");
+            BOOST_TEST(!js::compileHelper("1 +"));
+        }
     }
 
     void run()
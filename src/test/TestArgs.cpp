@@ -70,6 +70,11 @@ EXAMPLES:
     llvm::cl::desc("Run all or selected unit test suites."),
     llvm::cl::init(true))
 
+, manualOption(
+    "manual",
+    llvm::cl::desc("Run the manual test suites, such as the benchmarks."),
+    llvm::cl::init(false))
+
 , inputPaths(
     "inputs",
     llvm::cl::Sink,
@@ -105,7 +110,8 @@ hideForeignOptions()
         &action,
         std::addressof(inputPaths),
         &badOption,
-        &unitOption
+        &unitOption,
+        &manualOption
     });
 
     // Really hide the clang/llvm default
@@ -45,6 +45,7 @@ public:
     llvm::cl::opt<Action>       action;
     llvm::cl::opt<bool>         badOption;
     llvm::cl::opt<bool>         unitOption;
+    llvm::cl::opt<bool>         manualOption;
     llvm::cl::list<std::string> inputPaths;
     llvm::cl::opt<std::string>  addons;
     llvm::cl::list<std::string> systemIncludes;
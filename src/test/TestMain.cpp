@@ -88,6 +88,9 @@ int test_main(int argc, char const* const* argv)
     if(testArgs.unitOption.getValue())
         test_suite::unit_test_main(argc, argv);
 
+    if(testArgs.manualOption.getValue())
+        test_suite::manual_test_main(argc, argv);
+
     if( report::results.errorCount > 0 ||
         report::results.fatalCount > 0)
         return EXIT_FAILURE;
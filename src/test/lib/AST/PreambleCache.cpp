@@ -0,0 +1,164 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/AST/ASTVisitor.hpp"
+#include "lib/AST/PreambleCache.hpp"
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
+#include "lib/Metadata/Binary.hpp"
+#include "lib/Support/Path.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct PreambleCache_test
+{
+    ThreadPool threadPool_{1};
+
+    static
+    void
+    writeFile(std::string const& path, std::string_view text)
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+        BOOST_TEST(! ec);
+        os << text;
+    }
+
+    // Extract the translation units one after
+    // the other, so the results are ordered
+    static
+    InfoSet
+    extract(
+        ConfigImpl const& config,
+        std::string const& dir,
+        PreambleCache* preambles)
+    {
+        InfoExecutionContext context(config);
+        std::unique_ptr<tooling::FrontendActionFactory> action =
+            makeFrontendActionFactory(context, config, preambles);
+        tooling::FixedCompilationDatabase const compilations(
+            dir, std::vector<std::string>{ "-std=c++20" });
+        for (char const* name : { "a.cpp", "b.cpp", "c.cpp" })
+        {
+            tooling::ClangTool tool(compilations,
+                { files::appendPath(dir, name) },
+                std::make_shared<PCHContainerOperations>(),
+                llvm::vfs::createPhysicalFileSystem());
+            tool.setPrintErrorMessage(false);
+            BOOST_TEST(tool.run(action.get()) == 0);
+        }
+        return context.results().value();
+    }
+
+    static
+    Info const*
+    findByName(
+        InfoSet const& info,
+        std::string_view name)
+    {
+        for (auto const& I : info)
+        {
+            if (I->Name == name)
+            {
+                return I.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void
+    testReuse()
+    {
+        ScopedTempDirectory const dir("preamble-cache");
+        if (! BOOST_TEST(dir))
+            return;
+        std::string const path(dir.path());
+        std::string const header = files::appendPath(path, "header.hpp");
+        writeFile(header,
+            "#pragma once\n"
+            "/// A class from the header\n"
+            "struct Header\n"
+            "{\n"
+            "    int f();\n"
+            "};\n");
+        // the translation units have the same preamble
+        writeFile(files::appendPath(path, "a.cpp"),
+            "#include \"header.hpp\"\n"
+            "struct A : Header {};\n");
+        writeFile(files::appendPath(path, "b.cpp"),
+            "#include \"header.hpp\"\n"
+            "struct B : Header {};\n");
+        writeFile(files::appendPath(path, "c.cpp"),
+            "#include \"header.hpp\"\n"
+            "int c(Header& h) { return h.f(); }\n");
+
+        Config::Settings settings;
+        settings.sourceRoot = files::makeDirsy(path);
+        Config::Settings::ReferenceDirectories dirs;
+        auto const config = ConfigImpl::load(
+            settings, dirs, threadPool_).value();
+
+        InfoSet const parsed = extract(*config, path, nullptr);
+        PreambleCache preambles;
+        InfoSet const reused = extract(*config, path, &preambles);
+
+        // the first translation unit precompiles
+        // nothing, the others use the preamble
+        BOOST_TEST(preambles.built() == 1);
+        BOOST_TEST(preambles.hits() == 2);
+        BOOST_TEST(preambles.misses() == 1);
+
+        // the results are the same
+        BOOST_TEST(parsed.size() == reused.size());
+        BOOST_TEST(encodeInfoSet(parsed) == encodeInfoSet(reused));
+
+        // the declarations of the header are extracted
+        // with their location in the header
+        for (InfoSet const* info : { &parsed, &reused })
+        {
+            Info const* I = findByName(*info, "Header");
+            if (! BOOST_TEST(I))
+                continue;
+            auto const& R = static_cast<RecordInfo const&>(*I);
+            if (! BOOST_TEST(R.DefLoc))
+                continue;
+            BOOST_TEST(R.DefLoc->path() == files::makePosixStyle(header));
+            BOOST_TEST(R.DefLoc->LineNumber == 3);
+            BOOST_TEST(R.javadoc);
+            BOOST_TEST(findByName(*info, "f"));
+            BOOST_TEST(findByName(*info, "A"));
+            BOOST_TEST(findByName(*info, "B"));
+            BOOST_TEST(findByName(*info, "c"));
+        }
+
+        // ScopedTempDirectory only removes empty directories
+        llvm::sys::fs::remove_directories(path);
+    }
+
+    void run()
+    {
+        testReuse();
+    }
+};
+
+TEST_SUITE(
+    PreambleCache_test,
+    "clang.mrdocs.PreambleCache");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,278 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Dom.hpp>
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace dom {
+
+struct ObjectLookup_test
+{
+    static
+    std::vector<std::string>
+    makeKeys(std::size_t n)
+    {
+        // Keys with a common prefix, like the
+        // keys of the symbol objects
+        std::vector<std::string> keys;
+        keys.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            keys.push_back(fmt::format("symbol_key_{}", i));
+        return keys;
+    }
+
+    static
+    Object
+    makeObject(std::vector<std::string> const& keys)
+    {
+        Object::storage_type entries;
+        entries.reserve(keys.size());
+        for(std::size_t i = 0; i < keys.size(); ++i)
+            entries.emplace_back(keys[i], static_cast<std::int64_t>(i));
+        return Object(std::move(entries));
+    }
+
+    void
+    test_lookup()
+    {
+        // objects built with set() and with the
+        // constructor find the same entries
+        constexpr std::size_t threshold =
+            DefaultObjectImpl::index_threshold;
+        for(std::size_t n : {std::size_t(1), threshold, threshold + 1, std::size_t(100)})
+        {
+            auto keys = makeKeys(n);
+            Object o1 = makeObject(keys);
+            Object o2;
+            for(std::size_t i = 0; i < n; ++i)
+                o2.set(keys[i], static_cast<std::int64_t>(i));
+            BOOST_TEST(o1.size() == n);
+            BOOST_TEST(o2.size() == n);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                BOOST_TEST(o1.get(keys[i]) == static_cast<std::int64_t>(i));
+                BOOST_TEST(o2.get(keys[i]) == static_cast<std::int64_t>(i));
+            }
+            BOOST_TEST_NOT(o1.exists("missing"));
+            BOOST_TEST_NOT(o2.exists("missing"));
+            BOOST_TEST(o1.get("missing").isUndefined());
+
+            // insertion order is preserved
+            std::size_t i = 0;
+            o2.visit([&](String const& key, Value const&)
+            {
+                BOOST_TEST(key == keys[i++]);
+            });
+            BOOST_TEST(i == n);
+
+            // replacing a value keeps its position
+            o2.set(keys[0], "replaced");
+            BOOST_TEST(o2.size() == n);
+            BOOST_TEST(o2.get(keys[0]) == "replaced");
+        }
+
+        // the first of repeated keys is found
+        {
+            Object::storage_type entries;
+            for(std::size_t i = 0; i < 20; ++i)
+                entries.emplace_back("key", static_cast<std::int64_t>(i));
+            Object o(std::move(entries));
+            BOOST_TEST(o.get("key") == 0);
+        }
+    }
+
+    void run()
+    {
+        test_lookup();
+    }
+};
+
+TEST_SUITE(
+    ObjectLookup_test,
+    "clang.mrdocs.dom.ObjectLookup");
+
+/*  Benchmark of the key lookup in objects.
+
+    Objects searched linearly are compared with
+    the default implementation, which indexes the
+    keys of objects with more than index_threshold
+    entries. The cost of a lookup is measured along
+    with the cost of constructing the object, which
+    the index has to repay. The threshold should be
+    the size above which the indexed lookups are
+    faster than the linear ones.
+*/
+struct ObjectLookup_bench
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr std::size_t lookups = 1000000;
+    static constexpr std::size_t builds = 100000;
+    static constexpr int repeat = 5;
+
+    class LinearObjectImpl : public ObjectImpl
+    {
+        storage_type entries_;
+
+    public:
+        explicit
+        LinearObjectImpl(storage_type entries)
+            : entries_(std::move(entries))
+        {
+        }
+
+        std::size_t
+        size() const override
+        {
+            return entries_.size();
+        }
+
+        Value
+        get(std::string_view key) const override
+        {
+            for(auto const& kv : entries_)
+            {
+                if(kv.key == key)
+                    return kv.value;
+            }
+            return Kind::Undefined;
+        }
+
+        void
+        set(String key, Value value) override
+        {
+            entries_.emplace_back(std::move(key), std::move(value));
+        }
+
+        bool
+        visit(std::function<bool(String, Value)> visitor) const override
+        {
+            for(auto const& kv : entries_)
+            {
+                if(! visitor(kv.key, kv.value))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    // Return the best time of the runs, in
+    // nanoseconds per call of the function
+    template<class F>
+    static
+    double
+    measure(std::size_t calls, F&& f)
+    {
+        double best = 0;
+        for(int i = 0; i < repeat; ++i)
+        {
+            auto const start = clock_type::now();
+            for(std::size_t j = 0; j < calls; ++j)
+                f(j);
+            double const ns = std::chrono::duration<double, std::nano>(
+                clock_type::now() - start).count() / calls;
+            best = i == 0 ? ns : std::min(best, ns);
+        }
+        return best;
+    }
+
+    static
+    double
+    measureLookup(
+        Object const& o,
+        std::vector<std::string> const& keys)
+    {
+        std::int64_t sum = 0;
+        double const ns = measure(lookups, [&](std::size_t i)
+        {
+            sum += o.get(keys[i % keys.size()]).getInteger();
+        });
+        std::int64_t expected = 0;
+        for(std::size_t i = 0; i < lookups; ++i)
+            expected += static_cast<std::int64_t>(i % keys.size());
+        BOOST_TEST(sum == expected * repeat);
+        return ns;
+    }
+
+    template<class Make>
+    static
+    double
+    measureBuild(
+        Object::storage_type const& entries,
+        Make&& make)
+    {
+        std::size_t size = 0;
+        double const ns = measure(builds, [&](std::size_t)
+        {
+            size += make(Object::storage_type(entries)).size();
+        });
+        BOOST_TEST(size == entries.size() * builds * repeat);
+        return ns;
+    }
+
+    void
+    bench_lookup()
+    {
+        constexpr std::size_t threshold =
+            DefaultObjectImpl::index_threshold;
+        test_suite::log << fmt::format(
+            "dom::Object lookup, index_threshold = {}\n"
+            "{:>5} {:>12} {:>12} {:>14} {:>14}\n",
+            threshold, "keys", "linear hit", "default hit",
+            "linear build", "default build");
+        for(std::size_t n : {2, 4, 5, 6, 7, 8, 12, 16, 32})
+        {
+            auto keys = ObjectLookup_test::makeKeys(n);
+            Object const indexed = ObjectLookup_test::makeObject(keys);
+            Object::storage_type entries;
+            indexed.visit([&](String const& key, Value const& value)
+            {
+                entries.emplace_back(key, value);
+            });
+            Object const linear =
+                newObject<LinearObjectImpl>(entries);
+
+            double const linearHit = measureLookup(linear, keys);
+            double const indexedHit = measureLookup(indexed, keys);
+            double const linearBuild = measureBuild(entries,
+                [](Object::storage_type e)
+                {
+                    return newObject<LinearObjectImpl>(std::move(e));
+                });
+            double const indexedBuild = measureBuild(entries,
+                [](Object::storage_type e)
+                {
+                    return Object(std::move(e));
+                });
+            test_suite::log << fmt::format(
+                "{:>5} {:>9.1f} ns {:>9.1f} ns {:>11.0f} ns {:>11.0f} ns{}\n",
+                n, linearHit, indexedHit, linearBuild, indexedBuild,
+                n > threshold ? " (indexed)" : "");
+        }
+    }
+
+    void run()
+    {
+        bench_lookup();
+    }
+};
+
+TEST_SUITE_MANUAL(
+    ObjectLookup_bench,
+    "clang.mrdocs.dom.ObjectLookupBench");
+
+} // dom
+} // mrdocs
+} // clang
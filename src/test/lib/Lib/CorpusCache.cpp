@@ -0,0 +1,226 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/CorpusCache.hpp"
+#include "lib/Support/Path.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct CorpusCache_test
+{
+    ThreadPool threadPool_{1};
+
+    std::shared_ptr<ConfigImpl const>
+    makeConfig(Config::Settings const& settings)
+    {
+        Config::Settings::ReferenceDirectories dirs;
+        return ConfigImpl::load(settings, dirs, threadPool_).value();
+    }
+
+    static
+    void
+    writeFile(std::string const& path, std::string_view text)
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+        BOOST_TEST(! ec);
+        os << text;
+    }
+
+    static
+    std::vector<tooling::CompileCommand>
+    makeCommands(
+        std::string const& dir,
+        std::vector<std::string> args)
+    {
+        std::vector<tooling::CompileCommand> commands;
+        commands.emplace_back(dir, "a.cpp", std::move(args), "");
+        return commands;
+    }
+
+    // Store an entry with one symbol which
+    // depends on the specified files
+    static
+    void
+    storeEntry(
+        CorpusCache& cache,
+        ConfigImpl const& config,
+        std::string_view key,
+        std::vector<std::string> dependencies)
+    {
+        InfoExecutionContext ex(config);
+        CorpusCache::Recorder recorder(config, ex);
+        recorder.reportDependencies(std::move(dependencies));
+        InfoSet info;
+        info.emplace(std::make_unique<NamespaceInfo>(SymbolID::global));
+        recorder.report(std::move(info), Diagnostics());
+        BOOST_TEST(cache.store(key, recorder).has_value());
+    }
+
+    void
+    testKey()
+    {
+        ScopedTempDirectory const dir("corpus-cache");
+        if (! BOOST_TEST(dir))
+            return;
+        std::string const path(dir.path());
+        Config::Settings settings;
+        auto const config = makeConfig(settings);
+        CorpusCache const cache(files::appendPath(path, "cache"), *config);
+
+        auto const commands = makeCommands(
+            path, {"clang++", "-std=c++20", "a.cpp"});
+        std::string const key = cache.key(commands);
+        BOOST_TEST(key == cache.key(commands));
+
+        // a changed compile command misses
+        BOOST_TEST(key != cache.key(makeCommands(
+            path, {"clang++", "-std=c++17", "a.cpp"})));
+        BOOST_TEST(key != cache.key(makeCommands(
+            path, {"clang++", "-std=c++20", "-DNDEBUG", "a.cpp"})));
+        BOOST_TEST(key != cache.key(makeCommands(
+            files::appendPath(path, "build"),
+            {"clang++", "-std=c++20", "a.cpp"})));
+
+        // a changed extraction option misses
+        {
+            Config::Settings changed = settings;
+            changed.detectSfinae = ! settings.detectSfinae;
+            auto const other = makeConfig(changed);
+            CorpusCache const otherCache(
+                files::appendPath(path, "cache"), *other);
+            BOOST_TEST(key != otherCache.key(commands));
+        }
+        {
+            Config::Settings changed = settings;
+            changed.defines.push_back("EXTRA");
+            auto const other = makeConfig(changed);
+            CorpusCache const otherCache(
+                files::appendPath(path, "cache"), *other);
+            BOOST_TEST(key != otherCache.key(commands));
+        }
+
+        // options which do not change the symbols hit
+        {
+            Config::Settings changed = settings;
+            changed.multipage = ! settings.multipage;
+            changed.concurrency = settings.concurrency + 1;
+            auto const other = makeConfig(changed);
+            CorpusCache const otherCache(
+                files::appendPath(path, "cache"), *other);
+            BOOST_TEST(key == otherCache.key(commands));
+        }
+    }
+
+    void
+    testInvalidation()
+    {
+        ScopedTempDirectory const dir("corpus-cache");
+        if (! BOOST_TEST(dir))
+            return;
+        std::string const path(dir.path());
+        std::string const cacheDir = files::appendPath(path, "cache");
+        std::string const source = files::appendPath(path, "a.cpp");
+        std::string const header = files::appendPath(path, "a.hpp");
+        writeFile(source, "#include \"a.hpp\"\n");
+        writeFile(header, "struct A {};\n");
+
+        auto const config = makeConfig(Config::Settings());
+        auto const commands = makeCommands(path, {"clang++", "a.cpp"});
+        {
+            CorpusCache cache(cacheDir, *config);
+            std::string const key = cache.key(commands);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST_NOT(cache.load(key, ex));
+            BOOST_TEST(cache.misses() == 1);
+            storeEntry(cache, *config, key, {source, header});
+        }
+
+        // the stored results are reported
+        {
+            CorpusCache cache(cacheDir, *config);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST(cache.load(cache.key(commands), ex));
+            BOOST_TEST(cache.hits() == 1);
+            auto info = ex.results();
+            if (BOOST_TEST(info.has_value()))
+            {
+                BOOST_TEST(info->size() == 1);
+                BOOST_TEST(info->contains(SymbolID::global));
+            }
+        }
+
+        // a changed compile command misses
+        {
+            CorpusCache cache(cacheDir, *config);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST_NOT(cache.load(cache.key(makeCommands(
+                path, {"clang++", "-DEXTRA", "a.cpp"})), ex));
+            BOOST_TEST(cache.misses() == 1);
+        }
+
+        // a changed included header misses
+        writeFile(header, "struct A { int x; };\n");
+        {
+            CorpusCache cache(cacheDir, *config);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST_NOT(cache.load(cache.key(commands), ex));
+            BOOST_TEST(cache.misses() == 1);
+            auto info = ex.results();
+            if (BOOST_TEST(info.has_value()))
+                BOOST_TEST(info->empty());
+        }
+
+        // a removed header misses
+        llvm::sys::fs::remove(header);
+        {
+            CorpusCache cache(cacheDir, *config);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST_NOT(cache.load(cache.key(commands), ex));
+        }
+
+        // a changed extraction option misses
+        {
+            writeFile(header, "struct A {};\n");
+            CorpusCache cache(cacheDir, *config);
+            InfoExecutionContext ex(*config);
+            BOOST_TEST(cache.load(cache.key(commands), ex));
+
+            Config::Settings changed;
+            changed.detectSfinae = ! changed.detectSfinae;
+            auto const other = makeConfig(changed);
+            CorpusCache otherCache(cacheDir, *other);
+            InfoExecutionContext otherEx(*other);
+            BOOST_TEST_NOT(otherCache.load(
+                otherCache.key(commands), otherEx));
+        }
+
+        // ScopedTempDirectory only removes empty directories
+        llvm::sys::fs::remove_directories(path);
+    }
+
+    void run()
+    {
+        testKey();
+        testInvalidation();
+    }
+};
+
+TEST_SUITE(
+    CorpusCache_test,
+    "clang.mrdocs.CorpusCache");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,178 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/AST/ASTVisitor.hpp"
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
+#include "lib/Lib/HeaderDeclRegistry.hpp"
+#include "lib/Support/Path.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <span>
+
+namespace clang {
+namespace mrdocs {
+
+struct HeaderDeclRegistry_test
+{
+    ThreadPool threadPool_{1};
+
+    static
+    SymbolID
+    makeID(char c)
+    {
+        char data[20];
+        std::ranges::fill(data, c);
+        return SymbolID(data);
+    }
+
+    static
+    void
+    writeFile(std::string const& path, std::string_view text)
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+        BOOST_TEST(! ec);
+        os << text;
+    }
+
+    static
+    Info const*
+    findByName(
+        InfoSet const& info,
+        std::string_view name)
+    {
+        for (auto const& I : info)
+        {
+            if (I->Name == name)
+            {
+                return I.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void
+    testKeys()
+    {
+        HeaderDeclRegistry registry;
+        HeaderDeclRegistry::Key const a{ 1, makeID('a') };
+        HeaderDeclRegistry::Key const b{ 2, makeID('a') };
+        BOOST_TEST_NOT(registry.contains(a));
+        registry.insert(std::span(&a, 1));
+        BOOST_TEST(registry.contains(a));
+        // the same declaration in a different header
+        BOOST_TEST_NOT(registry.contains(b));
+    }
+
+    void
+    testExtract()
+    {
+        ScopedTempDirectory const dir("header-decls");
+        if (! BOOST_TEST(dir))
+            return;
+        std::string const path(dir.path());
+        writeFile(files::appendPath(path, "header.hpp"),
+            "#pragma once\n"
+            "struct Shared\n"
+            "{\n"
+            "    int f();\n"
+            "};\n"
+            "#ifdef WITH_EXTRA\n"
+            "struct Extra {};\n"
+            "#endif\n");
+        writeFile(files::appendPath(path, "a.cpp"),
+            "#include \"header.hpp\"\n"
+            "struct A : Shared {};\n");
+        // the header declares more things here
+        writeFile(files::appendPath(path, "b.cpp"),
+            "#define WITH_EXTRA\n"
+            "#include \"header.hpp\"\n"
+            "struct B : Extra {};\n");
+        // a macro the header does not consult
+        writeFile(files::appendPath(path, "c.cpp"),
+            "#define UNUSED 1\n"
+            "#include \"header.hpp\"\n"
+            "struct C : Shared {};\n");
+
+        Config::Settings settings;
+        settings.sourceRoot = files::makeDirsy(path);
+        settings.deduplicateHeaders = true;
+        Config::Settings::ReferenceDirectories dirs;
+        auto const config = ConfigImpl::load(
+            settings, dirs, threadPool_).value();
+
+        // Extract the translation units one after
+        // the other, so the results are ordered
+        InfoExecutionContext context(*config);
+        std::unique_ptr<tooling::FrontendActionFactory> action =
+            makeFrontendActionFactory(context, *config, nullptr);
+        tooling::FixedCompilationDatabase const compilations(
+            path, std::vector<std::string>{ "-std=c++20" });
+        for (char const* name : { "a.cpp", "b.cpp", "c.cpp" })
+        {
+            tooling::ClangTool tool(compilations,
+                { files::appendPath(path, name) },
+                std::make_shared<PCHContainerOperations>(),
+                llvm::vfs::createPhysicalFileSystem());
+            tool.setPrintErrorMessage(false);
+            BOOST_TEST(tool.run(action.get()) == 0);
+        }
+
+        // a.cpp extracts Shared, b.cpp extracts Shared
+        // and Extra again since WITH_EXTRA is defined,
+        // and c.cpp skips Shared
+        HeaderDeclRegistry const* registry = context.headerDecls();
+        if (BOOST_TEST(registry))
+        {
+            BOOST_TEST(registry->built() == 3);
+            BOOST_TEST(registry->skipped() == 1);
+        }
+
+        // the results of the translation units are merged
+        auto info = context.results();
+        if (BOOST_TEST(info.has_value()))
+        {
+            Info const* shared = findByName(*info, "Shared");
+            if (BOOST_TEST(shared))
+            {
+                auto const& R = static_cast<RecordInfo const&>(*shared);
+                BOOST_TEST(R.Members.size() == 1);
+            }
+            BOOST_TEST(findByName(*info, "f"));
+            BOOST_TEST(findByName(*info, "Extra"));
+            BOOST_TEST(findByName(*info, "A"));
+            BOOST_TEST(findByName(*info, "B"));
+            BOOST_TEST(findByName(*info, "C"));
+        }
+
+        // ScopedTempDirectory only removes empty directories
+        llvm::sys::fs::remove_directories(path);
+    }
+
+    void run()
+    {
+        testKeys();
+        testExtract();
+    }
+};
+
+TEST_SUITE(
+    HeaderDeclRegistry_test,
+    "clang.mrdocs.HeaderDeclRegistry");
+
+} // mrdocs
+} // clang
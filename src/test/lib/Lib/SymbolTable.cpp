@@ -0,0 +1,195 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/SymbolTable.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_set>
+
+namespace clang {
+namespace mrdocs {
+
+struct SymbolTable_test
+{
+    static
+    SymbolID
+    makeID(unsigned n)
+    {
+        // the first 8 bytes are shared by every
+        // 256 IDs, so the keys collide
+        char data[20]{};
+        data[0] = static_cast<char>(n >> 8);
+        data[19] = static_cast<char>(n);
+        return SymbolID(data);
+    }
+
+    void
+    testFind()
+    {
+        InfoSet info;
+        for(unsigned n = 1; n <= 1000; ++n)
+            info.emplace(std::make_unique<NamespaceInfo>(makeID(n)));
+        SymbolTable const table(info);
+        BOOST_TEST(table.size() == 1000);
+
+        // the dense indices follow the order of the IDs
+        BOOST_TEST(std::ranges::is_sorted(table.infos(), std::less<>(),
+            [](Info const* I) -> SymbolID const& { return I->id; }));
+
+        for(unsigned n = 1; n <= 1000; ++n)
+        {
+            SymbolID const id = makeID(n);
+            Info const* I = table.find(id);
+            if(BOOST_TEST(I))
+            {
+                BOOST_TEST(I->id == id);
+                BOOST_TEST(table.infos()[table.indexOf(id)] == I);
+            }
+        }
+        BOOST_TEST(! table.find(makeID(1001)));
+        BOOST_TEST(! table.find(SymbolID::global));
+        BOOST_TEST(! SymbolTable().find(makeID(1)));
+    }
+
+    void run()
+    {
+        testFind();
+    }
+};
+
+TEST_SUITE(
+    SymbolTable_test,
+    "clang.mrdocs.SymbolTable");
+
+/*  Benchmark of the symbol lookup.
+
+    Lookups of random IDs in a set hashed with the
+    string hash of the whole ID, as std::hash<SymbolID>
+    did before, are compared with lookups in the
+    InfoSet and in a SymbolTable of the same symbols.
+    Each lookup reads the kind of the symbol found.
+*/
+struct SymbolTable_bench
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr std::size_t lookups = 2000000;
+    static constexpr int repeat = 5;
+
+    struct StringHasher
+    {
+        using is_transparent = void;
+
+        std::size_t
+        operator()(std::unique_ptr<Info> const& I) const
+        {
+            return (*this)(I->id);
+        }
+
+        std::size_t
+        operator()(SymbolID const& id) const
+        {
+            return std::hash<std::string_view>()(std::string_view(id));
+        }
+    };
+
+    // Return the best time of the runs, in
+    // nanoseconds per lookup
+    template<class Find>
+    static
+    double
+    measure(
+        std::vector<SymbolID> const& ids,
+        Find&& find)
+    {
+        double best = 0;
+        for(int i = 0; i < repeat; ++i)
+        {
+            std::size_t found = 0;
+            auto const start = clock_type::now();
+            for(std::size_t j = 0; j < lookups; ++j)
+            {
+                Info const* I = find(ids[j % ids.size()]);
+                found += I && I->Kind != InfoKind::None;
+            }
+            double const ns = std::chrono::duration<double, std::nano>(
+                clock_type::now() - start).count() / lookups;
+            BOOST_TEST(found == lookups);
+            best = i == 0 ? ns : std::min(best, ns);
+        }
+        return best;
+    }
+
+    void
+    bench_find(std::size_t n)
+    {
+        std::mt19937_64 rng(n);
+        std::vector<SymbolID> ids;
+        InfoSet info;
+        std::unordered_set<std::unique_ptr<Info>,
+            StringHasher, InfoPtrEqual> stringSet;
+        while(info.size() < n)
+        {
+            char data[20];
+            for(char& c : data)
+                c = static_cast<char>(rng());
+            SymbolID const id(data);
+            if(info.emplace(std::make_unique<NamespaceInfo>(id)).second)
+            {
+                stringSet.emplace(std::make_unique<NamespaceInfo>(id));
+                ids.push_back(id);
+            }
+        }
+        SymbolTable const table(info);
+
+        // visit the symbols in random order
+        std::vector<SymbolID> order;
+        order.reserve(lookups);
+        for(std::size_t i = 0; i < lookups; ++i)
+            order.push_back(ids[rng() % ids.size()]);
+
+        double const stringNs = measure(order, [&](SymbolID const& id)
+        {
+            auto it = stringSet.find(id);
+            return it != stringSet.end() ? it->get() : nullptr;
+        });
+        double const setNs = measure(order, [&](SymbolID const& id)
+        {
+            auto it = info.find(id);
+            return it != info.end() ? it->get() : nullptr;
+        });
+        double const tableNs = measure(order, [&](SymbolID const& id)
+        {
+            return table.find(id);
+        });
+        test_suite::log << fmt::format(
+            "{:>8} {:>9.1f} ns {:>9.1f} ns {:>9.1f} ns\n",
+            n, stringNs, setNs, tableNs);
+    }
+
+    void run()
+    {
+        test_suite::log << fmt::format(
+            "Symbol lookup\n"
+            "{:>8} {:>12} {:>12} {:>12}\n",
+            "symbols", "string hash", "InfoSet", "SymbolTable");
+        for(std::size_t n : {1000, 60000, 500000})
+            bench_find(n);
+    }
+};
+
+TEST_SUITE_MANUAL(
+    SymbolTable_bench,
+    "clang.mrdocs.SymbolTableBench");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,408 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Metadata/Binary.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+
+namespace clang {
+namespace mrdocs {
+
+struct Binary_test
+{
+    static
+    SymbolID
+    makeID(char c)
+    {
+        char data[20];
+        std::ranges::fill(data, c);
+        return SymbolID(data);
+    }
+
+    static
+    std::unique_ptr<TypeInfo>
+    makeNamedType(std::string_view name)
+    {
+        auto N = std::make_unique<NameInfo>();
+        N->Name = name;
+        auto T = std::make_unique<NamedTypeInfo>();
+        T->Name = std::move(N);
+        return T;
+    }
+
+    static
+    InfoSet
+    makeInfoSet()
+    {
+        InfoSet info;
+
+        auto N = std::make_unique<NamespaceInfo>(makeID('n'));
+        N->Name = "ns";
+        N->Members = { makeID('r'), makeID('f') };
+        N->Lookups["S"] = { makeID('r') };
+        N->Lookups["f"] = { makeID('f') };
+        info.emplace(std::move(N));
+
+        auto R = std::make_unique<RecordInfo>(makeID('r'));
+        R->Name = "S";
+        R->Namespace = { makeID('n') };
+        R->KeyKind = RecordKeyKind::Class;
+        R->IsFinal = true;
+        R->DefLoc.emplace("/src/s.hpp", "s.hpp", 12, FileKind::Source, true);
+        R->Bases.emplace_back(makeNamedType("Base"), AccessKind::Public, true);
+        R->Template = std::make_unique<TemplateInfo>();
+        auto P = std::make_unique<TypeTParam>();
+        P->Name = "T";
+        P->IsParameterPack = true;
+        R->Template->Params.emplace_back(std::move(P));
+        info.emplace(std::move(R));
+
+        auto F = std::make_unique<FunctionInfo>(makeID('f'));
+        F->Name = "f";
+        F->Namespace = { makeID('n') };
+        F->ReturnType = makeNamedType("int");
+        F->Params.emplace_back(makeNamedType("S"), "s", "{}");
+        F->Noexcept.Kind = NoexceptKind::True;
+        F->Constexpr = ConstexprKind::Constexpr;
+        F->IsNodiscard = true;
+        doc::List<doc::Block> blocks;
+        auto brief = std::make_unique<doc::Brief>();
+        brief->children.emplace_back(
+            std::make_unique<doc::Text>("Return a value."));
+        blocks.emplace_back(std::move(brief));
+        auto param = std::make_unique<doc::Param>();
+        param->name = "s";
+        param->direction = doc::ParamDirection::in;
+        param->children.emplace_back(
+            std::make_unique<doc::Styled>("s", doc::Style::mono));
+        blocks.emplace_back(std::move(param));
+        F->javadoc = std::make_unique<Javadoc>(std::move(blocks));
+        info.emplace(std::move(F));
+
+        auto E = std::make_unique<EnumeratorInfo>(makeID('e'));
+        E->Name = "e";
+        E->Initializer.Written = "1 << 4";
+        E->Initializer.Value = 16;
+        info.emplace(std::move(E));
+
+        auto En = std::make_unique<EnumInfo>(makeID('E'));
+        En->Name = "Color";
+        En->Scoped = true;
+        En->UnderlyingType = makeNamedType("unsigned char");
+        En->Members = { makeID('e') };
+        info.emplace(std::move(En));
+
+        auto T = std::make_unique<TypedefInfo>(makeID('t'));
+        T->Name = "vec";
+        T->IsUsing = true;
+        T->Type = makeNamedType("vector");
+        T->Template = std::make_unique<TemplateInfo>();
+        T->Template->Params.emplace_back(std::make_unique<TypeTParam>());
+        info.emplace(std::move(T));
+
+        auto V = std::make_unique<VariableInfo>(makeID('v'));
+        V->Name = "v";
+        V->Type = makeNamedType("int");
+        V->Initializer.Written = "42";
+        V->StorageClass = StorageClassKind::Static;
+        V->IsThreadLocal = true;
+        info.emplace(std::move(V));
+
+        auto Fd = std::make_unique<FieldInfo>(makeID('d'));
+        Fd->Name = "bits";
+        Fd->Type = makeNamedType("unsigned");
+        Fd->IsBitfield = true;
+        Fd->BitfieldWidth.Written = "3";
+        Fd->BitfieldWidth.Value = 3;
+        Fd->HasNoUniqueAddress = true;
+        info.emplace(std::move(Fd));
+
+        auto Fr = std::make_unique<FriendInfo>(makeID('F'));
+        Fr->FriendSymbol = makeID('f');
+        Fr->FriendType = makeNamedType("S");
+        info.emplace(std::move(Fr));
+
+        auto G = std::make_unique<GuideInfo>(makeID('g'));
+        G->Name = "S";
+        auto Deduced = std::make_unique<SpecializationNameInfo>();
+        Deduced->Name = "S";
+        auto Arg = std::make_unique<TypeTArg>();
+        Arg->Type = makeNamedType("int");
+        Deduced->TemplateArgs.emplace_back(std::move(Arg));
+        auto DeducedType = std::make_unique<NamedTypeInfo>();
+        DeducedType->Name = std::move(Deduced);
+        G->Deduced = std::move(DeducedType);
+        G->Params.emplace_back(makeNamedType("int"), "i", "");
+        G->Explicit.Implicit = false;
+        G->Explicit.Kind = ExplicitKind::True;
+        info.emplace(std::move(G));
+
+        auto A = std::make_unique<AliasInfo>(makeID('a'));
+        A->Name = "fs";
+        A->AliasedSymbol = std::make_unique<NameInfo>();
+        A->AliasedSymbol->Name = "filesystem";
+        A->AliasedSymbol->id = makeID('n');
+        info.emplace(std::move(A));
+
+        auto U = std::make_unique<UsingInfo>(makeID('u'));
+        U->Class = UsingClass::Typename;
+        U->UsingSymbols = { makeID('r'), makeID('t') };
+        U->Qualifier = std::make_unique<NameInfo>();
+        U->Qualifier->Name = "ns";
+        info.emplace(std::move(U));
+
+        auto C = std::make_unique<ConceptInfo>(makeID('c'));
+        C->Name = "Integral";
+        C->Template = std::make_unique<TemplateInfo>();
+        C->Template->Params.emplace_back(std::make_unique<TypeTParam>());
+        C->Constraint.Written = "std::is_integral_v<T>";
+        info.emplace(std::move(C));
+
+        auto Sp = std::make_unique<SpecializationInfo>(makeID('s'));
+        Sp->Name = "S";
+        Sp->Primary = makeID('r');
+        auto SpArg = std::make_unique<NonTypeTArg>();
+        SpArg->Value.Written = "3";
+        Sp->Args.emplace_back(std::move(SpArg));
+        Sp->Members = { makeID('f') };
+        info.emplace(std::move(Sp));
+
+        return info;
+    }
+
+    void
+    testRoundTrip()
+    {
+        InfoSet const info = makeInfoSet();
+        std::string const data = encodeInfoSet(info);
+
+        auto decoded = decodeInfoSet(data);
+        if(! BOOST_TEST(decoded.has_value()))
+            return;
+        BOOST_TEST(decoded->size() == info.size());
+        // equal sets have the same encoding
+        BOOST_TEST(encodeInfoSet(*decoded) == data);
+
+        auto find = [&](char c) -> Info const*
+        {
+            auto it = decoded->find(makeID(c));
+            return it != decoded->end() ? it->get() : nullptr;
+        };
+
+        auto const* R = dynamic_cast<RecordInfo const*>(find('r'));
+        if(BOOST_TEST(R))
+        {
+            BOOST_TEST(R->Name == "S");
+            BOOST_TEST(R->IsFinal);
+            BOOST_TEST(R->KeyKind == RecordKeyKind::Class);
+            BOOST_TEST(R->DefLoc->LineNumber == 12);
+            BOOST_TEST(R->DefLoc->path() == "/src/s.hpp");
+            BOOST_TEST(R->DefLoc->filename() == "s.hpp");
+            // decoded locations refer to the interned file
+            BOOST_TEST(R->DefLoc->File == &internSourceFile(
+                "/src/s.hpp", "s.hpp", FileKind::Source));
+            BOOST_TEST(R->Bases.size() == 1);
+            BOOST_TEST(R->Bases[0].IsVirtual);
+            if(BOOST_TEST(R->Template))
+            {
+                BOOST_TEST(R->Template->Params.size() == 1);
+                BOOST_TEST(R->Template->Params[0]->IsParameterPack);
+            }
+        }
+
+        auto const* F = dynamic_cast<FunctionInfo const*>(find('f'));
+        if(BOOST_TEST(F))
+        {
+            BOOST_TEST(F->Params.size() == 1);
+            BOOST_TEST(F->Params[0].Default == "{}");
+            BOOST_TEST(F->Noexcept.Kind == NoexceptKind::True);
+            BOOST_TEST(F->IsNodiscard);
+            if(BOOST_TEST(F->javadoc))
+                BOOST_TEST(F->javadoc->getBlocks().size() == 2);
+        }
+
+        auto const* N = dynamic_cast<NamespaceInfo const*>(find('n'));
+        if(BOOST_TEST(N))
+        {
+            BOOST_TEST(N->Members.size() == 2);
+            BOOST_TEST(N->Lookups.size() == 2);
+        }
+
+        auto const* E = dynamic_cast<EnumeratorInfo const*>(find('e'));
+        if(BOOST_TEST(E))
+        {
+            BOOST_TEST(E->Initializer.Written == "1 << 4");
+            BOOST_TEST(E->Initializer.Value == 16);
+        }
+
+        auto const* En = dynamic_cast<EnumInfo const*>(find('E'));
+        if(BOOST_TEST(En))
+        {
+            BOOST_TEST(En->Scoped);
+            BOOST_TEST(En->Members.size() == 1);
+            if(BOOST_TEST(En->UnderlyingType))
+                BOOST_TEST(En->UnderlyingType->isNamed());
+        }
+
+        auto const* T = dynamic_cast<TypedefInfo const*>(find('t'));
+        if(BOOST_TEST(T))
+        {
+            BOOST_TEST(T->IsUsing);
+            BOOST_TEST(T->Type);
+            if(BOOST_TEST(T->Template))
+                BOOST_TEST(T->Template->Params.size() == 1);
+        }
+
+        auto const* V = dynamic_cast<VariableInfo const*>(find('v'));
+        if(BOOST_TEST(V))
+        {
+            BOOST_TEST(V->Initializer.Written == "42");
+            BOOST_TEST(V->StorageClass == StorageClassKind::Static);
+            BOOST_TEST(V->IsThreadLocal);
+            BOOST_TEST_NOT(V->IsConstinit);
+        }
+
+        auto const* Fd = dynamic_cast<FieldInfo const*>(find('d'));
+        if(BOOST_TEST(Fd))
+        {
+            BOOST_TEST(Fd->IsBitfield);
+            BOOST_TEST(Fd->BitfieldWidth.Written == "3");
+            BOOST_TEST(Fd->BitfieldWidth.Value == 3);
+            BOOST_TEST(Fd->HasNoUniqueAddress);
+            BOOST_TEST_NOT(Fd->IsMutable);
+        }
+
+        auto const* Fr = dynamic_cast<FriendInfo const*>(find('F'));
+        if(BOOST_TEST(Fr))
+        {
+            BOOST_TEST(Fr->FriendSymbol == makeID('f'));
+            BOOST_TEST(Fr->FriendType);
+        }
+
+        auto const* G = dynamic_cast<GuideInfo const*>(find('g'));
+        if(BOOST_TEST(G))
+        {
+            BOOST_TEST(G->Params.size() == 1);
+            BOOST_TEST_NOT(G->Explicit.Implicit);
+            BOOST_TEST(G->Explicit.Kind == ExplicitKind::True);
+            auto const* Deduced = G->Deduced && G->Deduced->isNamed() ?
+                static_cast<NamedTypeInfo const&>(*G->Deduced).Name.get() :
+                nullptr;
+            if(BOOST_TEST(Deduced) &&
+                BOOST_TEST(Deduced->isSpecialization()))
+            {
+                BOOST_TEST(static_cast<SpecializationNameInfo const&>(
+                    *Deduced).TemplateArgs.size() == 1);
+            }
+        }
+
+        auto const* A = dynamic_cast<AliasInfo const*>(find('a'));
+        if(BOOST_TEST(A) && BOOST_TEST(A->AliasedSymbol))
+        {
+            BOOST_TEST(A->AliasedSymbol->Name == "filesystem");
+            BOOST_TEST(A->AliasedSymbol->id == makeID('n'));
+        }
+
+        auto const* U = dynamic_cast<UsingInfo const*>(find('u'));
+        if(BOOST_TEST(U))
+        {
+            BOOST_TEST(U->Class == UsingClass::Typename);
+            BOOST_TEST(U->UsingSymbols.size() == 2);
+            if(BOOST_TEST(U->Qualifier))
+                BOOST_TEST(U->Qualifier->Name == "ns");
+        }
+
+        auto const* C = dynamic_cast<ConceptInfo const*>(find('c'));
+        if(BOOST_TEST(C))
+        {
+            BOOST_TEST(C->Constraint.Written == "std::is_integral_v<T>");
+            BOOST_TEST(C->Template);
+        }
+
+        auto const* Sp = dynamic_cast<SpecializationInfo const*>(find('s'));
+        if(BOOST_TEST(Sp))
+        {
+            BOOST_TEST(Sp->Primary == makeID('r'));
+            BOOST_TEST(Sp->Members.size() == 1);
+            if(BOOST_TEST(Sp->Args.size() == 1))
+            {
+                BOOST_TEST(Sp->Args[0]->Kind == TArgKind::NonType);
+                BOOST_TEST(static_cast<NonTypeTArg const&>(
+                    *Sp->Args[0]).Value.Written == "3");
+            }
+        }
+
+        // every kind of symbol is encoded
+        #define INFO_PASCAL(Type) \
+        BOOST_TEST(std::ranges::any_of(*decoded, \
+            [](auto const& I) { return I->is##Type(); }));
+        #include <mrdocs/Metadata/InfoNodes.inc>
+    }
+
+    void
+    testInvalid()
+    {
+        std::string const data = encodeInfoSet(makeInfoSet());
+        BOOST_TEST(! decodeInfoSet({}));
+        BOOST_TEST(! decodeInfoSet("MRDX"));
+        // truncated data is rejected
+        for(std::size_t n : { std::size_t(5), data.size() / 2, data.size() - 1 })
+            BOOST_TEST(! decodeInfoSet(std::string_view(data).substr(0, n)));
+    }
+
+    void
+    testCorpus()
+    {
+        InfoSet const info = makeInfoSet();
+        std::string const data = encodeCorpus(info);
+
+        auto view = CorpusView::create(data);
+        if(! BOOST_TEST(view.has_value()))
+            return;
+        BOOST_TEST(view->size() == info.size());
+        for(std::size_t i = 1; i < view->size(); ++i)
+            BOOST_TEST(view->id(i - 1) < view->id(i));
+
+        auto F = view->find(makeID('f'));
+        if(BOOST_TEST(F.has_value()) && BOOST_TEST(*F))
+        {
+            BOOST_TEST((*F)->Kind == InfoKind::Function);
+            BOOST_TEST((*F)->Name == "f");
+        }
+        auto missing = view->find(makeID('x'));
+        if(BOOST_TEST(missing.has_value()))
+            BOOST_TEST(! *missing);
+
+        auto all = view->readAll();
+        if(BOOST_TEST(all.has_value()))
+            BOOST_TEST(encodeCorpus(*all) == data);
+
+        BOOST_TEST(! CorpusView::create({}));
+        BOOST_TEST(! CorpusView::create(encodeInfoSet(info)));
+        // truncated data is rejected
+        auto truncated = CorpusView::create(
+            std::string_view(data).substr(0, data.size() - 1));
+        bool const failed = ! truncated || ! truncated->readAll();
+        BOOST_TEST(failed);
+    }
+
+    void run()
+    {
+        testRoundTrip();
+        testInvalid();
+        testCorpus();
+    }
+};
+
+TEST_SUITE(
+    Binary_test,
+    "clang.mrdocs.metadata.Binary");
+
+} // mrdocs
+} // clang
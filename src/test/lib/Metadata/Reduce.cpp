@@ -0,0 +1,211 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Metadata/Reduce.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace clang {
+namespace mrdocs {
+
+struct Reduce_test
+{
+    static
+    SymbolID
+    makeID(unsigned n)
+    {
+        char data[20]{};
+        for(std::size_t i = 0; i < sizeof(n); ++i)
+            data[i] = static_cast<char>(n >> (8 * i));
+        return SymbolID(data);
+    }
+
+    // A namespace reported by a translation
+    // unit which saw the given members
+    static
+    NamespaceInfo
+    makeNamespace(std::vector<unsigned> const& members)
+    {
+        NamespaceInfo I(makeID(~0u));
+        for(unsigned n : members)
+        {
+            I.Members.push_back(makeID(n));
+            I.Lookups[fmt::format("m{}", n)].push_back(makeID(n));
+        }
+        return I;
+    }
+
+    static
+    std::vector<unsigned>
+    range(unsigned first, unsigned last)
+    {
+        std::vector<unsigned> v;
+        for(unsigned n = first; n < last; ++n)
+            v.push_back(n);
+        return v;
+    }
+
+    void
+    testMerge(unsigned size)
+    {
+        // the members keep the order in which they
+        // were first seen and are not repeated
+        NamespaceInfo I = makeNamespace(range(1, size));
+        auto other = range(size / 2, size + size / 2);
+        std::ranges::reverse(other);
+        merge(I, makeNamespace(other));
+        BOOST_TEST(I.Members.size() == size + size / 2 - 1);
+        for(unsigned n = 1; n < size; ++n)
+            BOOST_TEST(I.Members[n - 1] == makeID(n));
+        for(unsigned n = size; n < size + size / 2; ++n)
+            BOOST_TEST(I.Members[size - 1 + (size + size / 2 - 1 - n)] == makeID(n));
+
+        BOOST_TEST(I.Lookups.size() == I.Members.size());
+        for(auto const& [name, ids] : I.Lookups)
+            BOOST_TEST(ids.size() == 1);
+
+        // overloads share a name
+        NamespaceInfo J = makeNamespace({});
+        J.Lookups["f"] = {makeID(1), makeID(2)};
+        NamespaceInfo K = makeNamespace({});
+        K.Lookups["f"] = {makeID(3), makeID(1)};
+        merge(J, std::move(K));
+        BOOST_TEST(J.Lookups["f"] ==
+            std::vector<SymbolID>({makeID(1), makeID(2), makeID(3)}));
+    }
+
+    void run()
+    {
+        // short lists are searched, long
+        // ones are merged through a table
+        testMerge(10);
+        testMerge(1000);
+    }
+};
+
+TEST_SUITE(
+    Reduce_test,
+    "clang.mrdocs.Reduce");
+
+/*  Benchmark of the merge of large scopes.
+
+    Each translation unit reports a random 80% of
+    the members of a namespace, in their order of
+    declaration, along with their lookups. The time
+    to merge all the reports with merge() is compared
+    with the search of the merged list for each ID,
+    as reduceSymbolIDs did for every list before.
+    Building the reports is not measured.
+*/
+struct Reduce_bench
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static
+    void
+    linearReduce(
+        std::vector<SymbolID>& list,
+        std::vector<SymbolID>&& otherList)
+    {
+        for(auto const& id : otherList)
+        {
+            if(std::ranges::find(list, id) == list.end())
+                list.push_back(id);
+        }
+    }
+
+    static
+    void
+    linearMerge(NamespaceInfo& I, NamespaceInfo&& Other)
+    {
+        linearReduce(I.Members, std::move(Other.Members));
+        for(auto& [name, ids] : Other.Lookups)
+            linearReduce(I.Lookups[name], std::move(ids));
+    }
+
+    // Return the time to merge the reports, in milliseconds
+    template<class Merge>
+    static
+    double
+    measure(
+        std::size_t members,
+        std::size_t units,
+        Merge&& mergeInto)
+    {
+        std::mt19937 rng(static_cast<unsigned>(members));
+        std::vector<unsigned> ids;
+        for(unsigned n = 1; n <= members; ++n)
+            ids.push_back(n);
+        auto report = [&]
+        {
+            std::vector<unsigned> seen;
+            for(unsigned n : ids)
+            {
+                if(rng() % 5 != 0)
+                    seen.push_back(n);
+            }
+            return Reduce_test::makeNamespace(seen);
+        };
+        NamespaceInfo I = report();
+        clock_type::duration total{};
+        for(std::size_t i = 1; i < units; ++i)
+        {
+            NamespaceInfo other = report();
+            auto const start = clock_type::now();
+            mergeInto(I, std::move(other));
+            total += clock_type::now() - start;
+        }
+        BOOST_TEST(I.Members.size() <= members);
+        BOOST_TEST(I.Lookups.size() == I.Members.size());
+        return std::chrono::duration<double, std::milli>(total).count();
+    }
+
+    void
+    bench_merge(
+        std::size_t members,
+        std::size_t units,
+        bool linear)
+    {
+        double const linearMs = linear
+            ? measure(members, units, linearMerge)
+            : 0;
+        double const mergeMs = measure(members, units,
+            [](NamespaceInfo& I, NamespaceInfo&& Other)
+            {
+                merge(I, std::move(Other));
+            });
+        test_suite::log << fmt::format(
+            "{:>8} {:>6} {:>12} {:>9.0f} ms\n",
+            members, units,
+            linear ? fmt::format("{:.0f} ms", linearMs) : "-",
+            mergeMs);
+    }
+
+    void run()
+    {
+        test_suite::log << fmt::format(
+            "Scope merge\n"
+            "{:>8} {:>6} {:>12} {:>12}\n",
+            "members", "TUs", "linear", "merge");
+        bench_merge(100, 2000, true);
+        bench_merge(1000, 200, true);
+        bench_merge(5000, 200, true);
+        bench_merge(20000, 2000, false);
+    }
+};
+
+TEST_SUITE_MANUAL(
+    Reduce_bench,
+    "clang.mrdocs.ReduceBench");
+
+} // mrdocs
+} // clang
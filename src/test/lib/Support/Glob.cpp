@@ -0,0 +1,240 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Glob.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+
+namespace clang {
+namespace mrdocs {
+
+struct Glob_test
+{
+    void
+    testGlobPattern()
+    {
+        std::string_view const patterns[] = {
+            "", "*", "**", "?", "a", "a*", "*a", "*a*", "a*b",
+            "a?c", "*.hpp", "src/*/*.cpp", "a*b*c", "a**b",
+            "?*?", "*ab*ab*"};
+        std::string_view const strs[] = {
+            "", "a", "b", "ab", "abc", "axc", "aab", "acb",
+            "abab", "ababab", "aabcc", "x.hpp", ".hpp",
+            "src/lib/a.cpp", "src/a.cpp", "src/lib/a.hpp"};
+        // the compiled pattern agrees with globMatch
+        for (std::string_view pattern : patterns)
+        {
+            GlobPattern const compiled(pattern);
+            for (std::string_view str : strs)
+            {
+                if (globMatch(pattern, str))
+                {
+                    BOOST_TEST(compiled.match(str));
+                }
+                else
+                {
+                    BOOST_TEST_NOT(compiled.match(str));
+                }
+            }
+        }
+        BOOST_TEST(GlobPattern("src/*?.cpp").prefix() == "src/");
+        BOOST_TEST(GlobPattern("a?c").prefix() == "a");
+    }
+
+    void
+    testGlobSet()
+    {
+        std::string const patterns[] = {
+            "*.hpp", "src/lib/*.cpp", "src/test/*", "include/mrdocs/?.h"};
+        GlobSet const set(patterns);
+        BOOST_TEST(! set.empty());
+        BOOST_TEST(set.match("a.hpp"));
+        BOOST_TEST(set.match("src/lib/AST/a.cpp"));
+        BOOST_TEST(set.match("src/test/a.txt"));
+        BOOST_TEST(set.match("include/mrdocs/a.h"));
+        BOOST_TEST(! set.match("include/mrdocs/ab.h"));
+        BOOST_TEST(! set.match("src/tool/a.cpp"));
+        BOOST_TEST(! set.match("src/lib/a.ipp"));
+        BOOST_TEST(GlobSet().empty());
+        BOOST_TEST(! GlobSet().match("a"));
+    }
+
+    void
+    testPrefixSet()
+    {
+        std::string const prefixes[] = {
+            "/home/user/project/include/", "C:\\project\\src"};
+        PrefixSet const set(prefixes);
+        BOOST_TEST(set.match("/home/user/project/include/a.hpp"));
+        BOOST_TEST(set.match("/home/user/project/include/"));
+        BOOST_TEST(! set.match("/home/user/project/include"));
+        BOOST_TEST(! set.match("/home/user/project/src/a.cpp"));
+        BOOST_TEST(set.match("C:/project/src/a.cpp"));
+        BOOST_TEST(set.match("C:\\project\\src\\a.cpp"));
+        BOOST_TEST(! set.match("C:/project/include/a.hpp"));
+    }
+
+    void
+    testInputFilter()
+    {
+        std::string const include[] = { "/project/include/" };
+        std::string const patterns[] = { "*.hpp", "*.h" };
+        BOOST_TEST(InputFilter().empty());
+        BOOST_TEST(InputFilter().match("/a.cpp"));
+        InputFilter const filter(include, patterns);
+        BOOST_TEST(! filter.empty());
+        BOOST_TEST(filter.match("/project/include/a.hpp"));
+        BOOST_TEST(! filter.match("/project/include/a.cpp"));
+        BOOST_TEST(! filter.match("/project/src/a.hpp"));
+        InputFilter const onlyPatterns({}, patterns);
+        BOOST_TEST(onlyPatterns.match("/project/src/a.hpp"));
+        BOOST_TEST(! onlyPatterns.match("/project/src/a.cpp"));
+    }
+
+    void run()
+    {
+        testGlobPattern();
+        testGlobSet();
+        testPrefixSet();
+        testInputFilter();
+    }
+};
+
+TEST_SUITE(
+    Glob_test,
+    "clang.mrdocs.Glob");
+
+/*  Benchmark of the input filter.
+
+    The linear scan of the include prefixes and
+    file patterns, as done for each file before
+    the filter was compiled, is compared with an
+    InputFilter built from the same config.
+*/
+struct Glob_bench
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr int repeat = 5;
+
+    // Return the best time of the runs, in milliseconds
+    template<class F>
+    static
+    double
+    measure(F&& f)
+    {
+        double best = 0;
+        for (int i = 0; i < repeat; ++i)
+        {
+            auto const start = clock_type::now();
+            f();
+            double const ms = std::chrono::duration<double, std::milli>(
+                clock_type::now() - start).count();
+            best = i == 0 ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+    static
+    bool
+    linearMatch(
+        std::span<std::string const> include,
+        std::span<std::string const> patterns,
+        std::string_view path)
+    {
+        if (!include.empty() &&
+            std::ranges::none_of(include, [path](std::string const& prefix)
+            {
+                return files::startsWith(path, prefix);
+            }))
+        {
+            return false;
+        }
+        return patterns.empty() ||
+            std::ranges::any_of(patterns, [path](std::string const& pattern)
+            {
+                return globMatch(pattern, path);
+            });
+    }
+
+    void
+    bench_filter(
+        std::size_t nInclude,
+        std::size_t nPatterns,
+        std::size_t nPaths)
+    {
+        // Include directories of many modules, patterns
+        // for the headers of each module, and paths of
+        // headers and sources spread over the modules
+        std::vector<std::string> include;
+        for (std::size_t i = 0; i < nInclude; ++i)
+            include.push_back(fmt::format(
+                "/home/user/project/modules/module{}/include/", i));
+        std::vector<std::string> patterns;
+        for (std::size_t i = 0; i < nPatterns; ++i)
+            patterns.push_back(fmt::format(
+                "/home/user/project/modules/module{}/*/detail{}/*.h*", i, i % 7));
+        std::vector<std::string> paths;
+        for (std::size_t i = 0; i < nPaths; ++i)
+            paths.push_back(fmt::format(
+                "/home/user/project/modules/module{}/{}/detail{}/file{}.{}",
+                (i * 7919) % (nInclude + nInclude / 4 + 1),
+                i % 3 ? "include" : "src", i % 5, i,
+                i % 2 ? "hpp" : "cpp"));
+
+        std::size_t linearCount = 0;
+        double const linearMs = measure([&]
+        {
+            linearCount = std::ranges::count_if(paths, [&](std::string const& path)
+            {
+                return linearMatch(include, patterns, path);
+            });
+        });
+        double const compileMs = measure([&]
+        {
+            InputFilter const filter(include, patterns);
+            BOOST_TEST(!filter.empty());
+        });
+        InputFilter const filter(include, patterns);
+        std::size_t filterCount = 0;
+        double const filterMs = measure([&]
+        {
+            filterCount = std::ranges::count_if(paths, [&](std::string const& path)
+            {
+                return filter.match(path);
+            });
+        });
+        BOOST_TEST(linearCount == filterCount);
+        test_suite::log << fmt::format(
+            "{:>8} {:>8} {:>6} {:>6} {:>9.2f} ms {:>9.2f} ms {:>9.2f} ms\n",
+            nInclude, nPatterns, nPaths, filterCount,
+            linearMs, compileMs, filterMs);
+    }
+
+    void run()
+    {
+        test_suite::log << fmt::format(
+            "Input filter\n"
+            "{:>8} {:>8} {:>6} {:>6} {:>12} {:>12} {:>12}\n",
+            "prefixes", "patterns", "paths", "match",
+            "linear", "compile", "filter");
+        bench_filter(10, 10, 5000);
+        bench_filter(100, 100, 5000);
+        bench_filter(2000, 2000, 5000);
+    }
+};
+
+TEST_SUITE_MANUAL(
+    Glob_bench,
+    "clang.mrdocs.GlobBench");
+
+} // mrdocs
+} // clang
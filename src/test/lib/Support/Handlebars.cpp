@@ -5246,6 +5246,107 @@ to_dom(llvm::json::Value& val)
     return res;
 };
 
+void
+compiled_templates()
+{
+    Handlebars hbs;
+
+    // compiled template renders the same as the template text
+    {
+        std::string_view templ =
+            "{{#each people as |p|}}\n"
+            "  {{#if p.first~}}\n"
+            "    {{p.name}}\n"
+            "  {{~else if p.last}}\n"
+            "    [{{p.name}}]\n"
+            "  {{else}}\n"
+            "    <{{p.name}}>\n"
+            "  {{/if}}\n"
+            "{{^}}\n"
+            "none\n"
+            "{{/each}}\n"
+            "{{{{raw}}}} {{p.name}} {{{{/raw}}}}\n"
+            "\\{{escaped}} \\\\{{people.length}}\n";
+        hbs.registerHelper("raw", [](dom::Value const& options) {
+            return options.get("fn")();
+        });
+        dom::Array people;
+        for (std::string_view name: {"a", "b", "c"})
+        {
+            dom::Object person;
+            person.set("name", name);
+            person.set("first", name == "a");
+            person.set("last", name == "c");
+            people.emplace_back(person);
+        }
+        dom::Object ctx;
+        ctx.set("people", people);
+        HandlebarsTemplate compiled = hbs.compile(templ);
+        BOOST_TEST_NOT(compiled.empty());
+        BOOST_TEST(compiled.text() == templ);
+        BOOST_TEST(hbs.render(compiled, ctx) == hbs.render(templ, ctx));
+        HandlebarsOptions opt;
+        opt.ignoreStandalone = true;
+        BOOST_TEST(hbs.render(compiled, ctx, opt) == hbs.render(templ, ctx, opt));
+
+        // compiled template can be rendered many times
+        ctx.set("people", dom::Array{});
+        BOOST_TEST(hbs.render(compiled, ctx) == hbs.render(templ, ctx));
+    }
+
+    // compiled template owns the template text
+    {
+        HandlebarsTemplate compiled;
+        BOOST_TEST(compiled.empty());
+        {
+            std::string templ = "{{#with person}}{{name}}{{/with}}";
+            compiled = hbs.compile(templ);
+        }
+        dom::Object person;
+        person.set("name", "John");
+        dom::Object ctx;
+        ctx.set("person", person);
+        BOOST_TEST(hbs.render(compiled, ctx) == "John");
+    }
+
+    // compiled templates resolve helpers and partials when rendered
+    {
+        HandlebarsTemplate compiled = hbs.compile(
+            "{{#> layout}}{{#*inline \"content\"}}{{greet name}}{{/inline}}{{/layout}}");
+        hbs.registerPartial("layout", "<{{> content}}>");
+        hbs.registerHelper("greet", [](dom::Value const& name) {
+            return fmt::format("Hello, {}", name);
+        });
+        dom::Object ctx;
+        ctx.set("name", "World");
+        BOOST_TEST(hbs.render(compiled, ctx) == "<Hello, World>");
+        hbs.registerPartial("layout", "[{{> content}}]");
+        BOOST_TEST(hbs.render(compiled, ctx) == "[Hello, World]");
+    }
+
+    // compiled partials can be shared by several environments
+    {
+        HandlebarsTemplate partial = Handlebars::compile("({{name}})");
+        Handlebars hbs2;
+        hbs.registerPartial("shared", partial);
+        hbs2.registerPartial("shared", partial);
+        dom::Object ctx;
+        ctx.set("name", "World");
+        BOOST_TEST(hbs.render("{{> shared}}", ctx) == "(World)");
+        BOOST_TEST(hbs2.render("{{> shared}}", ctx) == "(World)");
+    }
+
+    // errors are the same as when rendering the template text
+    {
+        std::string_view templ = "{{#if true}}unclosed";
+        auto exp = hbs.try_render(hbs.compile(templ), dom::Object{}, {});
+        BOOST_TEST_NOT(exp);
+        auto exp2 = hbs.try_render(templ, dom::Object{}, {});
+        BOOST_TEST_NOT(exp2);
+        BOOST_TEST(std::string_view(exp.error().what()) == exp2.error().what());
+    }
+}
+
 void
 mustache_compat_spec()
 {
@@ -5350,6 +5451,11 @@ mustache_compat_spec()
             {
                 return;
             }
+            rendered = hbs.render(hbs.compile(template_str), context, opt);
+            if (!BOOST_TEST(rendered == expected))
+            {
+                return;
+            }
         }
     }
 }
@@ -5383,6 +5489,7 @@ run()
     strict();
     assume_objects();
     utils();
+    compiled_templates();
     mustache_compat_spec();
 }
 
@@ -0,0 +1,107 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Metadata/Name.hpp>
+#include <mrdocs/Metadata/Type.hpp>
+#include <mrdocs/Support/NodePool.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct NodePool_test
+{
+    void
+    testAllocate()
+    {
+        std::vector<std::pair<void*, std::size_t>> nodes;
+        for(std::size_t size : { 1, 8, 16, 24, 100, 512, 513, 4096 })
+        {
+            void* p = allocateNode(size);
+            BOOST_TEST(reinterpret_cast<std::uintptr_t>(p) %
+                __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+            // the memory is usable
+            std::memset(p, 0xcd, size);
+            nodes.emplace_back(p, size);
+        }
+        for(auto [p, size] : nodes)
+            deallocateNode(p, size);
+    }
+
+    void
+    testNodes()
+    {
+        auto T = std::make_unique<PointerTypeInfo>();
+        T->PointeeType = std::make_unique<NamedTypeInfo>();
+        BOOST_TEST(T->innerType() == T->PointeeType.get());
+
+        // nodes can be destroyed by another thread
+        std::unique_ptr<TypeInfo> U = std::move(T);
+        std::thread([&]{ U.reset(); }).join();
+        BOOST_TEST(! U);
+    }
+
+    void
+    testReuse()
+    {
+#if defined(__SANITIZE_ADDRESS__)
+        return;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+        return;
+#endif
+#endif
+        // nodes allocated by one thread and freed
+        // by another are reused once both exit
+        constexpr std::size_t size = 200;
+        constexpr std::size_t count = 2000;
+        std::vector<void*> nodes;
+        std::thread([&]
+        {
+            for(std::size_t i = 0; i < count; ++i)
+                nodes.push_back(allocateNode(size));
+        }).join();
+        std::thread([&]
+        {
+            for(void* p : nodes)
+                deallocateNode(p, size);
+        }).join();
+
+        std::vector<void*> reused;
+        std::thread([&]
+        {
+            for(std::size_t i = 0; i < count; ++i)
+                reused.push_back(allocateNode(size));
+        }).join();
+        std::ranges::sort(nodes);
+        std::ranges::sort(reused);
+        BOOST_TEST(nodes == reused);
+        for(void* p : reused)
+            deallocateNode(p, size);
+    }
+
+    void run()
+    {
+        testAllocate();
+        testNodes();
+        testReuse();
+    }
+};
+
+TEST_SUITE(
+    NodePool_test,
+    "clang.mrdocs.NodePool");
+
+} // mrdocs
+} // clang
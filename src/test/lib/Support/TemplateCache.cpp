@@ -0,0 +1,84 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Path.hpp"
+#include "lib/Support/TemplateCache.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct TemplateCache_test
+{
+    static
+    void
+    writeFile(std::string const& path, std::string_view text)
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_Text);
+        BOOST_TEST(! ec);
+        os << text;
+    }
+
+    static
+    std::string
+    render(
+        TemplateCache const& cache,
+        std::string_view name)
+    {
+        auto tmpl = cache.get(name);
+        if (! BOOST_TEST(tmpl.has_value()))
+            return {};
+        dom::Object context;
+        context.set("name", "world");
+        return Handlebars().render(*tmpl, context);
+    }
+
+    void
+    testGet()
+    {
+        ScopedTempDirectory const dir("template-cache");
+        if (! BOOST_TEST(dir))
+            return;
+        std::string const path(dir.path());
+        std::string const a = files::appendPath(path, "a.hbs");
+        std::string const b = files::appendPath(path, "b.hbs");
+        writeFile(a, "a {{name}}");
+
+        TemplateCache const cache(path);
+        BOOST_TEST(render(cache, "a.hbs") == "a world");
+
+        // the templates loaded upon construction
+        // are not read again
+        llvm::sys::fs::remove(a);
+        BOOST_TEST(render(cache, "a.hbs") == "a world");
+
+        // a template added later is loaded once
+        writeFile(b, "b {{name}}");
+        BOOST_TEST(render(cache, "b.hbs") == "b world");
+        llvm::sys::fs::remove(b);
+        BOOST_TEST(render(cache, "b.hbs") == "b world");
+
+        BOOST_TEST_NOT(cache.get("missing.hbs").has_value());
+    }
+
+    void run()
+    {
+        testGet();
+    }
+};
+
+TEST_SUITE(
+    TemplateCache_test,
+    "clang.mrdocs.TemplateCache");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,93 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <test_suite/test_suite.hpp>
+
+namespace clang {
+namespace mrdocs {
+
+struct Trace_test
+{
+    void
+    testWrite()
+    {
+        trace::enable();
+        {
+            trace::Span span("outer", "test");
+            span.arg("count", std::int64_t(3));
+            span.arg("file", std::string("a.cpp"));
+            trace::Span inner("inner", "test");
+            inner.arg("ms", 1.5);
+        }
+
+        ScopedTempFile const path("trace", "json");
+        if (! BOOST_TEST(path))
+            return;
+        BOOST_TEST(trace::write(path.path()).has_value());
+
+        auto buffer = llvm::MemoryBuffer::getFile(path.path());
+        if (! BOOST_TEST(buffer))
+            return;
+        auto json = llvm::json::parse((*buffer)->getBuffer());
+        if (! BOOST_TEST(bool(json)))
+        {
+            llvm::consumeError(json.takeError());
+            return;
+        }
+        auto const* events = json->getAsObject()->getArray("traceEvents");
+        if (! BOOST_TEST(events))
+            return;
+
+        // spans from other tests may be recorded too
+        llvm::json::Object const* outer = nullptr;
+        llvm::json::Object const* inner = nullptr;
+        for (auto const& event : *events)
+        {
+            auto const* obj = event.getAsObject();
+            if (*obj->getString("cat") != "test")
+                continue;
+            if (*obj->getString("name") == "outer")
+                outer = obj;
+            else if (*obj->getString("name") == "inner")
+                inner = obj;
+        }
+        if (BOOST_TEST(outer))
+        {
+            BOOST_TEST(*outer->getString("ph") == "X");
+            auto const* args = outer->getObject("args");
+            if (BOOST_TEST(args))
+            {
+                BOOST_TEST(*args->getInteger("count") == 3);
+                BOOST_TEST(*args->getString("file") == "a.cpp");
+            }
+        }
+        if (BOOST_TEST(inner))
+        {
+            // the inner span is nested in the outer one
+            BOOST_TEST(*inner->getInteger("ts") >= *outer->getInteger("ts"));
+            BOOST_TEST(*inner->getObject("args")->getNumber("ms") == 1.5);
+        }
+    }
+
+    void run()
+    {
+        testWrite();
+    }
+};
+
+TEST_SUITE(
+    Trace_test,
+    "clang.mrdocs.Trace");
+
+} // mrdocs
+} // clang
@@ -469,13 +469,14 @@ test(
 
 //------------------------------------------------
 
-int run(std::ostream& out)
+int run(std::ostream& out, bool manual)
 {
     simple_runner any_runner(out);
     suites::instance().sort();
     for(any_suite const* sp :
             suites::instance())
-        any_runner.run(*sp);
+        if(sp->manual() == manual)
+            any_runner.run(*sp);
     return any_runner.success() ?
         EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -497,7 +498,13 @@ int unit_test_main(int argc, char const* const* argv)
 #endif
 
     ::test_suite::debug_stream dstream(std::cerr);
-    return ::test_suite::detail::run(dstream);
+    return ::test_suite::detail::run(dstream, false);
+}
+
+int manual_test_main(int, char const* const*)
+{
+    ::test_suite::debug_stream dstream(std::cerr);
+    return ::test_suite::detail::run(dstream, true);
 }
 
 } // test_suite
@@ -38,6 +38,10 @@ struct any_suite
     virtual ~any_suite() = 0;
     virtual char const* name() const noexcept = 0;
     virtual void run() const = 0;
+
+    // Manual suites, such as benchmarks, only
+    // run when they are explicitly requested
+    virtual bool manual() const noexcept = 0;
 };
 
 //------------------------------------------------
@@ -63,11 +67,15 @@ template<class T>
 class suite : public any_suite
 {
     char const* name_;
+    bool manual_;
 
 public:
     explicit
-    suite(char const* name) noexcept
+    suite(
+        char const* name,
+        bool manual = false) noexcept
         : name_(name)
+        , manual_(manual)
     {
         suites::instance().insert(*this);
     }
@@ -78,6 +86,12 @@ public:
         return name_;
     }
 
+    bool
+    manual() const noexcept override
+    {
+        return manual_;
+    }
+
     void
     run() const override
     {
@@ -381,8 +395,14 @@ constexpr detail::log_type log{};
 #define TEST_SUITE(type, name) \
     static ::test_suite::suite<type> type##_(name)
 
+#define TEST_SUITE_MANUAL(type, name) \
+    static ::test_suite::suite<type> type##_(name, true)
+
 extern int unit_test_main(int argc, char const* const* argv);
 
+// Run the manual suites
+extern int manual_test_main(int argc, char const* const* argv);
+
 } // test_suite
 
 #endif
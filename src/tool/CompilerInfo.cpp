@@ -12,8 +12,13 @@
 #include "CompilerInfo.hpp"
 
 #include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Path.hpp>
 
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
 
 namespace clang {
 namespace mrdocs {
@@ -81,38 +86,139 @@ parseIncludePaths(std::string const& compilerOutput)
     return includePaths;
 }
 
+namespace {
+
+// The name of the file caching the include paths
+// of a compiler. The name changes when the
+// compiler executable is replaced.
+std::optional<std::string>
+includePathsCacheFile(
+    llvm::StringRef compilerPath,
+    llvm::StringRef cacheDir)
+{
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(compilerPath, status))
+    {
+        return std::nullopt;
+    }
+    std::string s = compilerPath.str();
+    s.push_back('\0');
+    s.append(std::to_string(status.getSize()));
+    s.push_back('\0');
+    s.append(std::to_string(status.getLastModificationTime()
+        .time_since_epoch().count()));
+    std::string name = llvm::toHex(llvm::SHA1::hash(
+        llvm::arrayRefFromStringRef(s)), true);
+    name.append(".txt");
+    return files::appendPath(cacheDir, "compilers", name);
+}
+
+} // (anon)
+
+std::optional<std::vector<std::string>>
+getCompilerIncludePaths(
+    llvm::StringRef compilerPath,
+    llvm::StringRef cacheDir)
+{
+    std::optional<std::string> cacheFile;
+    if (!cacheDir.empty())
+    {
+        cacheFile = includePathsCacheFile(compilerPath, cacheDir);
+    }
+    if (cacheFile)
+    {
+        if (auto buffer = llvm::MemoryBuffer::getFile(*cacheFile))
+        {
+            std::vector<std::string> includePaths;
+            llvm::SmallVector<llvm::StringRef> lines;
+            (*buffer)->getBuffer().split(lines, '\n', -1, false);
+            for (llvm::StringRef line : lines)
+            {
+                includePaths.push_back(line.str());
+            }
+            return includePaths;
+        }
+    }
+
+    auto const compilerOutput = getCompilerVerboseOutput(compilerPath);
+    if (!compilerOutput)
+    {
+        return std::nullopt;
+    }
+    std::vector<std::string> includePaths = parseIncludePaths(*compilerOutput);
+
+    // A failure to write the cache is not an error.
+    // The file is written to a temporary file first,
+    // so readers never see a partial file.
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if (cacheFile &&
+        !llvm::sys::fs::create_directories(files::getParentDir(*cacheFile)) &&
+        !llvm::sys::fs::createUniqueFile(*cacheFile + ".%%%%%%%%.tmp", fd, tempPath))
+    {
+        bool failed;
+        {
+            llvm::raw_fd_ostream os(fd, true);
+            for (auto const& path : includePaths)
+            {
+                os << path << '\n';
+            }
+            os.close();
+            failed = os.has_error();
+            os.clear_error();
+        }
+        if (failed || llvm::sys::fs::rename(tempPath, *cacheFile))
+        {
+            llvm::sys::fs::remove(tempPath);
+        }
+    }
+    return includePaths;
+}
+
 std::unordered_map<std::string, std::vector<std::string>> 
-getCompilersDefaultIncludeDir(clang::tooling::CompilationDatabase const& compDb, bool useSystemStdlib) 
+getCompilersDefaultIncludeDir(
+    clang::tooling::CompilationDatabase const& compDb,
+    bool useSystemStdlib,
+    ThreadPool& threadPool,
+    llvm::StringRef cacheDir)
 {
     if (!useSystemStdlib)
     {
         return {};
     }
-    std::unordered_map<std::string, std::vector<std::string>> res;
-    auto const allCommands = compDb.getAllCompileCommands();
 
-    for (auto const& cmd : allCommands)
+    // Find the distinct compilers first, so each
+    // of them is probed once. The entries are
+    // created before probing, so the probes
+    // only write to their own entry.
+    std::unordered_map<std::string, std::vector<std::string>> res;
+    std::vector<std::pair<std::string const, std::vector<std::string>>*> compilers;
+    for (auto const& cmd : compDb.getAllCompileCommands())
     {
         if (!cmd.CommandLine.empty())
         {
-            auto const& compilerPath = cmd.CommandLine[0];
-            if (res.contains(compilerPath))
+            auto [it, emplaced] = res.try_emplace(cmd.CommandLine[0]);
+            if (emplaced)
             {
-                continue;
+                compilers.push_back(&*it);
             }
+        }
+    }
 
-            std::vector<std::string> includePaths;
-            auto const compilerOutput = getCompilerVerboseOutput(compilerPath);
-            if (!compilerOutput)
+    auto errors = threadPool.forEach(compilers,
+        [&](auto* compiler)
+        {
+            auto includePaths = getCompilerIncludePaths(
+                compiler->first, cacheDir);
+            if (includePaths)
             {
-                res.emplace(compilerPath, includePaths);
-                continue;
+                compiler->second = std::move(*includePaths);
             }
-            includePaths = parseIncludePaths(*compilerOutput);
-            res.emplace(compilerPath, std::move(includePaths));
-        }
+        });
+    for (auto const& err : errors)
+    {
+        report::warn("Failed to probe compiler: {}", err);
     }
-
     return res;
 }
 
@@ -16,6 +16,7 @@
 #include <vector>
 #include <unordered_map>
 
+#include <mrdocs/Support/ThreadPool.hpp>
 #include <clang/Tooling/CompilationDatabase.h>
 #include <llvm/ADT/StringRef.h>
 
@@ -40,15 +41,37 @@ getCompilerVerboseOutput(llvm::StringRef compilerPath);
 std::vector<std::string> 
 parseIncludePaths(std::string const& compilerOutput);
 
+/**
+ * @brief Get the compiler default include paths.
+ *
+ * The include paths are read from the verbose output of the compiler,
+ * or from the cache directory when the compiler was already probed.
+ *
+ * @param compilerPath The compiler path.
+ * @param cacheDir The directory where the include paths are cached, or empty.
+ * @return std::optional<std::vector<std::string>> The include paths.
+*/
+std::optional<std::vector<std::string>>
+getCompilerIncludePaths(llvm::StringRef compilerPath, llvm::StringRef cacheDir);
+
 /**
  * @brief Get the compiler default include dir.
- * 
+ *
+ * Each distinct compiler is probed once, and the compilers
+ * are probed concurrently.
+ *
  * @param compDb The compilation database.
  * @param useSystemStdlib True if the compiler has to use just the system standard library.
+ * @param threadPool The thread pool used to probe the compilers.
+ * @param cacheDir The directory where the include paths are cached, or empty.
  * @return std::unordered_map<std::string, std::vector<std::string>> The compiler default include dir.
 */
 std::unordered_map<std::string, std::vector<std::string>> 
-getCompilersDefaultIncludeDir(clang::tooling::CompilationDatabase const& compDb, bool useSystemStdlib);
+getCompilersDefaultIncludeDir(
+    clang::tooling::CompilationDatabase const& compDb,
+    bool useSystemStdlib,
+    ThreadPool& threadPool,
+    llvm::StringRef cacheDir = {});
 
 } // mrdocs
 } // clang
@@ -16,6 +16,7 @@
 #include "lib/Lib/CorpusImpl.hpp"
 #include "lib/Lib/MrDocsCompilationDatabase.hpp"
 #include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
 #include "llvm/Support/Program.h"
 #include <mrdocs/Generators.hpp>
 #include <mrdocs/Support/Error.hpp>
@@ -39,11 +40,17 @@ namespace {
  *
  * @param inputPath The path to the project, which can be a directory, a `compile_commands.json` file, or a `CMakeLists.txt` file.
  * @param cmakeArgs The arguments to pass to CMake when generating the compilation database.
+ * @param buildDir The temporary directory where CMake runs.
+ * @param cacheDir The directory where the CMake build directory is cached, or empty.
  * @return An `Expected` object containing the path to the `compile_commands.json` file if the database is generated, or the provided path if it is already the `compile_commands.json` file. 
  * Returns an `Unexpected` object in case of failure (e.g., file not found, CMake execution failure).
  */
 Expected<std::string>
-generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs, llvm::StringRef buildDir)
+generateCompileCommandsFile(
+    llvm::StringRef inputPath,
+    llvm::StringRef cmakeArgs,
+    llvm::StringRef buildDir,
+    llvm::StringRef cacheDir)
 {
     namespace fs = llvm::sys::fs;
     namespace path = llvm::sys::path;
@@ -57,7 +64,7 @@ generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs
     // --------------------------------------------------------------
     if (fs::is_directory(fileStatus))
     {
-        return executeCmakeExportCompileCommands(inputPath, cmakeArgs, buildDir);
+        return executeCmakeExportCompileCommands(inputPath, cmakeArgs, buildDir, cacheDir);
     }
 
     // --------------------------------------------------------------
@@ -68,7 +75,7 @@ generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs
     {
         std::string cmakeSourceDir = files::getParentDir(inputPath);
         return executeCmakeExportCompileCommands(
-            cmakeSourceDir, cmakeArgs, buildDir);
+            cmakeSourceDir, cmakeArgs, buildDir, cacheDir);
     }
 
     // --------------------------------------------------------------
@@ -82,41 +89,12 @@ generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs
     return Unexpected(Error("Input path is not a directory, a CMakeLists.txt file, or a compile_commands.json file"));
 }
 
-} // anonymous namespace
-
-
-Expected<void>
-DoGenerateAction(
-    std::string const& configPath,
-    Config::Settings::ReferenceDirectories const& dirs,
-    char const** argv)
+/** Build the corpus from the compilation database of the configuration.
+ */
+Expected<std::unique_ptr<Corpus>>
+buildCorpus(std::shared_ptr<ConfigImpl const> const& config)
 {
-    // --------------------------------------------------------------
-    //
-    // Load configuration
-    //
-    // --------------------------------------------------------------
-    Config::Settings publicSettings;
-    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
-    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
-    MRDOCS_TRY(publicSettings.normalize(dirs));
-    ThreadPool threadPool(publicSettings.concurrency);
-    MRDOCS_TRY(
-        std::shared_ptr<ConfigImpl const> config,
-        ConfigImpl::load(publicSettings, dirs, threadPool));
-
-    // --------------------------------------------------------------
-    //
-    // Load generator
-    //
-    // --------------------------------------------------------------
     auto& settings = config->settings();
-    MRDOCS_TRY(
-        Generator const& generator,
-        getGenerators().find(to_string(settings.generate)),
-        formatError(
-            "the Generator \"{}\" was not found",
-            to_string(config->settings().generate)));
 
     // --------------------------------------------------------------
     //
@@ -136,9 +114,12 @@ DoGenerateAction(
         "The compilation database path argument is missing");
     ScopedTempDirectory tempDir("mrdocs");
     std::string buildPath = files::appendPath(tempDir.path(), "build");
+    trace::Span cmakeSpan("Generate compilation database");
     Expected<std::string> const compileCommandsPathExp =
         generateCompileCommandsFile(
-            compilationDatabasePath, settings.cmake, buildPath);
+            compilationDatabasePath, settings.cmake, buildPath,
+            settings.cacheDir);
+    cmakeSpan.end();
     if (!compileCommandsPathExp)
     {
         report::error(
@@ -169,30 +150,102 @@ DoGenerateAction(
     clang::tooling::JSONCompilationDatabase& jsonDatabase = *jsonDatabasePtr;
 
     // Custom compilation database that applies settings from the configuration
+    trace::Span probeSpan("Probe compilers");
     auto const defaultIncludePaths = getCompilersDefaultIncludeDir(
-        jsonDatabase, (*config)->useSystemStdlib);
+        jsonDatabase, (*config)->useSystemStdlib,
+        config->threadPool(), (*config)->cacheDir);
+    probeSpan.arg("compilers", static_cast<std::int64_t>(defaultIncludePaths.size()));
+    probeSpan.end();
     auto compileCommandsDir = files::getParentDir(compileCommandsPath);
+    trace::Span adjustSpan("Adjust compile commands");
     MrDocsCompilationDatabase compilationDatabase(
         compileCommandsDir,
         jsonDatabase,
         config,
         defaultIncludePaths);
+    adjustSpan.end();
 
     // --------------------------------------------------------------
     //
     // Build corpus
     //
     // --------------------------------------------------------------
+    return CorpusImpl::build(
+        report::Level::info, config, compilationDatabase);
+}
+
+} // anonymous namespace
+
+
+Expected<void>
+DoGenerateAction(
+    std::string const& configPath,
+    Config::Settings::ReferenceDirectories const& dirs,
+    char const** argv)
+{
+    // --------------------------------------------------------------
+    //
+    // Load configuration
+    //
+    // --------------------------------------------------------------
+    Config::Settings publicSettings;
+    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
+    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
+    MRDOCS_TRY(publicSettings.normalize(dirs));
+    ThreadPool threadPool(publicSettings.concurrency);
     MRDOCS_TRY(
-        std::unique_ptr<Corpus> corpus,
-        CorpusImpl::build(
-            report::Level::info, config, compilationDatabase));
+        std::shared_ptr<ConfigImpl const> config,
+        ConfigImpl::load(publicSettings, dirs, threadPool));
+    if (!publicSettings.traceFile.empty())
+    {
+        trace::enable();
+    }
+
+    // --------------------------------------------------------------
+    //
+    // Load generator
+    //
+    // --------------------------------------------------------------
+    auto& settings = config->settings();
+    MRDOCS_TRY(
+        Generator const& generator,
+        getGenerators().find(to_string(settings.generate)),
+        formatError(
+            "the Generator \"{}\" was not found",
+            to_string(config->settings().generate)));
+
+    // --------------------------------------------------------------
+    //
+    // Load or build the corpus
+    //
+    // --------------------------------------------------------------
+    std::unique_ptr<Corpus> corpus;
+    if (!settings.corpusInput.empty())
+    {
+        trace::Span loadSpan("Load corpus");
+        MRDOCS_TRY(
+            corpus,
+            CorpusImpl::load(
+                report::Level::info, config, settings.corpusInput));
+    }
+    else
+    {
+        MRDOCS_TRY(corpus, buildCorpus(config));
+    }
     if (corpus->empty())
     {
         report::warn("Corpus is empty, not generating docs");
         return {};
     }
 
+    if (!settings.corpusOutput.empty())
+    {
+        MRDOCS_TRY(
+            static_cast<CorpusImpl const&>(*corpus).save(
+                settings.corpusOutput));
+        report::info("Saved the corpus to \"{}\"", settings.corpusOutput);
+    }
+
     // --------------------------------------------------------------
     //
     // Generate docs
@@ -205,7 +258,21 @@ DoGenerateAction(
             settings.output,
             (*config)->configDir));
     report::info("Generating docs\n");
+    trace::Span generateSpan("Generate documentation");
+    generateSpan.arg("generator", std::string(generator.id()));
     MRDOCS_TRY(generator.build(absOutput, *corpus));
+    generateSpan.end();
+
+    // --------------------------------------------------------------
+    //
+    // Save the trace
+    //
+    // --------------------------------------------------------------
+    if (!settings.traceFile.empty())
+    {
+        MRDOCS_TRY(trace::write(settings.traceFile));
+        report::info("Saved the trace to \"{}\"", settings.traceFile);
+    }
 
     // --------------------------------------------------------------
     //